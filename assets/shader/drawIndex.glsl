@@ -0,0 +1,10 @@
+// Index of the per-draw data of the draws issued by CDrawBatcher, included by vertex shaders before any declaration.
+// The programs are created with CDrawBatcher::getDefines( ), the draws pass the index as their base instance if it
+// sets LEARNOGL_DRAW_INDEX_BASE_INSTANCE and write it to u_baseInstance otherwise
+#ifdef LEARNOGL_DRAW_INDEX_BASE_INSTANCE
+#extension GL_ARB_shader_draw_parameters : require
+#define DRAW_INDEX gl_BaseInstanceARB
+#else
+uniform int u_baseInstance;
+#define DRAW_INDEX u_baseInstance
+#endif
@@ -0,0 +1,26 @@
+// shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in float pointSize;
+
+uniform float u_pointScale = 1.0;
+
+void main()
+{
+    gl_Position = position;
+    gl_PointSize = pointSize * u_pointScale;
+}
+
+// shader fragment
+#version 330 core
+
+#include "objectData.glsl"
+
+layout(location = 0) out vec4 color;
+
+// Stands in for programs still compiling, the magenta tint marks the placeholder
+void main()
+{
+    color = mix(u_color, vec4(1.0, 0.0, 1.0, 1.0), 0.75);
+}
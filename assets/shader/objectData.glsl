@@ -0,0 +1,5 @@
+// Per-draw data, written to a slice of the uniform buffer ring for every draw
+layout(std140) uniform ObjectData
+{
+    vec4 u_color;
+};
@@ -4,18 +4,20 @@
 layout(location = 0) in vec4 position;
 layout(location = 1) in float pointSize;
 
+uniform float u_pointScale = 1.0;
+
 void main()
 {
     gl_Position = position;
-    gl_PointSize = pointSize;
+    gl_PointSize = pointSize * u_pointScale;
 }
 
 // shader fragment
 #version 330 core
 
-layout(location = 0) out vec4 color;
+#include "objectData.glsl"
 
-uniform vec4 u_color;
+layout(location = 0) out vec4 color;
 
 void main()
 {
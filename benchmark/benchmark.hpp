@@ -0,0 +1,86 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "fmt/core.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+/// Keeps the compiler from removing a computation whose result is otherwise unused.
+template<typename T>
+inline auto doNotOptimize(T const & value) -> void
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(*static_cast<T const volatile*>(&value));
+#endif
+}
+
+/// Runs the workload repeatedly for at least the minimum time and returns the time of the fastest run, which is the
+/// least disturbed by the rest of the system.
+template<typename TWorkload>
+auto measure(
+    TWorkload&&                     workload,
+    std::chrono::milliseconds const minTime        = std::chrono::milliseconds{250},
+    std::size_t const               minRepetitions = 5) -> std::chrono::nanoseconds
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::chrono::nanoseconds fastest{std::chrono::nanoseconds::max( )};
+    Clock::time_point const  start{Clock::now( )};
+    for(std::size_t repetition{ }; (repetition < minRepetitions) || ((Clock::now( ) - start) < minTime); ++repetition)
+    {
+        Clock::time_point const runStart{Clock::now( )};
+        workload( );
+        fastest = std::min(fastest, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now( ) - runStart));
+    }
+    return fastest;
+}
+
+/// Prints the time of a run and the throughput of the bytes it read.
+inline auto printThroughput(
+    std::string_view const name, std::size_t const numBytes, std::chrono::nanoseconds const time) -> void
+{
+    double const seconds{std::chrono::duration<double>(time).count( )};
+    double const gigabytesPerSecond{(static_cast<double>(numBytes) / seconds) * 1e-9};
+    fmt::print("{:<48} {:>10.3f} ms {:>8.2f} GB/s\n", name, seconds * 1e3, gigabytesPerSecond);
+}
+
+/// Prints the time of a run and the rate of the items it processed, in millions per second.
+inline auto printRate(
+    std::string_view const name, std::size_t const numItems, std::string_view const unit,
+    std::chrono::nanoseconds const time) -> void
+{
+    double const seconds{std::chrono::duration<double>(time).count( )};
+    double const millionsPerSecond{(static_cast<double>(numItems) / seconds) * 1e-6};
+    fmt::print("{:<48} {:>10.3f} ms {:>8.2f} M{}/s\n", name, seconds * 1e3, millionsPerSecond, unit);
+}
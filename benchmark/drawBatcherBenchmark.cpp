@@ -0,0 +1,212 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "benchmark.hpp"
+#include "deviceCaps.hpp"
+#include "drawBatcher.hpp"
+#include "program.hpp"
+#include "stateAccess.hpp"
+#include "stateCache.hpp"
+
+#include "fmt/core.h"
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+// Every draw moves its triangle by its draw index, which the batched draws read from the base instance
+constexpr std::string_view k_shaderSource{R"(// shader vertex
+#version 330 core
+
+#include "drawIndex.glsl"
+
+layout(location = 0) in vec2 position;
+
+void main()
+{
+    vec2 offset = vec2(DRAW_INDEX % 256, (DRAW_INDEX / 256) % 256) / 128.0 - 1.0;
+    gl_Position = vec4(position + offset, 0.0, 1.0);
+}
+
+// shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+void main()
+{
+    color = vec4(1.0);
+}
+)"};
+
+constexpr std::array<GLfloat, 6>     k_positions{0.0F, 0.0F, 0.005F, 0.0F, 0.0F, 0.005F};
+constexpr std::array<GLushort, 3>    k_indices{0, 1, 2};
+constexpr std::array<std::size_t, 3> k_numDraws{1'000, 10'000, 100'000};
+
+// The draws of one frame issued one by one, the index of each draw written to the u_baseInstance uniform
+auto drawImmediate(CProgram& program, GLuint const vertexArray, std::size_t const numDraws) -> void
+{
+    CStateCache& stateCache{CStateCache::get( )};
+    stateCache.useProgram(program.getId( ));
+    stateCache.bindVertexArray(vertexArray);
+
+    GLint const location{program.getUniformLocation(CDrawBatcher::k_baseInstance)};
+    for(std::size_t i{ }; i < numDraws; ++i)
+    {
+        program.setUniform(location, static_cast<GLint>(i));
+        glDrawElementsBaseVertex(GL_TRIANGLES, 3, GL_UNSIGNED_SHORT, nullptr, 0);
+    }
+    glFinish( );
+}
+
+auto drawBatched(CDrawBatcher& batcher, CProgram& program, GLuint const vertexArray, std::size_t const numDraws)
+    -> void
+{
+    for(std::size_t i{ }; i < numDraws; ++i)
+    {
+        batcher.add(program, vertexArray, GL_TRIANGLES, GL_UNSIGNED_SHORT, {3, 1, 0, 0, static_cast<GLuint>(i)});
+    }
+    batcher.flush( );
+    batcher.endFrame( );
+    glFinish( );
+}
+
+auto run( ) -> void
+{
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+    glfwWindowHint(GLFW_CONTEXT_NO_ERROR, GLFW_TRUE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* const window{glfwCreateWindow(64, 64, "Draw batcher benchmark", nullptr, nullptr)};
+    if(nullptr == window)
+    {
+        throw std::runtime_error("Failed to create GLFW window.");
+    }
+    glfwMakeContextCurrent(window);
+    if(!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+    {
+        throw std::runtime_error("Failed to initialize GLAD.");
+    }
+
+    CDeviceCaps deviceCaps{ };
+    deviceCaps.create( );
+    CStateAccess::select(deviceCaps, true);
+    fmt::print("{}, {}\n", deviceCaps.getRenderer( ), deviceCaps.getVersion( ));
+
+    // The shader includes drawIndex.glsl next to it, the benchmark runs from the root of the repository like the
+    // application
+    std::filesystem::path const directory{std::filesystem::temp_directory_path( )};
+    std::filesystem::path const shaderFilePath{directory / "learnogl-draw-benchmark.shader"};
+    std::filesystem::copy_file(
+        "assets/shader/drawIndex.glsl", directory / "drawIndex.glsl",
+        std::filesystem::copy_options::overwrite_existing);
+    std::ofstream{shaderFilePath, std::ios::binary} << k_shaderSource;
+
+    CDrawBatcher batcher{ };
+    batcher.create(deviceCaps);
+
+    CProgram immediateProgram{ };
+    immediateProgram.create(shaderFilePath);
+    CProgram batchedProgram{ };
+    batchedProgram.create(shaderFilePath, nullptr, batcher.getDefines( ));
+
+    std::filesystem::remove(shaderFilePath);
+    std::filesystem::remove(directory / "drawIndex.glsl");
+
+    CStateCache&          stateCache{CStateCache::get( )};
+    GLuint                vertexArray{ };
+    std::array<GLuint, 2> buffers{ };
+    glGenVertexArrays(1, &vertexArray);
+    glGenBuffers(static_cast<GLsizei>(buffers.size( )), buffers.data( ));
+    stateCache.bindVertexArray(vertexArray);
+    stateCache.bindBuffer(GL_ARRAY_BUFFER, buffers.at(0));
+    glBufferData(GL_ARRAY_BUFFER, sizeof(k_positions), k_positions.data( ), GL_STATIC_DRAW);
+    stateCache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.at(1));
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(k_indices), k_indices.data( ), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(0);
+
+    for(std::size_t const numDraws : k_numDraws)
+    {
+        printRate(fmt::format("{} draws, immediate", numDraws), numDraws, "draws", measure([&]( ) {
+            drawImmediate(immediateProgram, vertexArray, numDraws);
+        }));
+        printRate(
+            fmt::format("{} draws, {} batcher", numDraws, batcher.isIndirect( ) ? "indirect" : "separate"), numDraws,
+            "draws", measure([&]( ) { drawBatched(batcher, batchedProgram, vertexArray, numDraws); }));
+    }
+
+    stateCache.bindVertexArray(0);
+    for(GLuint const buffer : buffers)
+    {
+        stateCache.forgetBuffer(buffer);
+    }
+    stateCache.forgetVertexArray(vertexArray);
+    glDeleteBuffers(static_cast<GLsizei>(buffers.size( )), buffers.data( ));
+    glDeleteVertexArrays(1, &vertexArray);
+    batcher.destroy( );
+    immediateProgram.destroy( );
+    batchedProgram.destroy( );
+    glfwDestroyWindow(window);
+}
+}
+
+/// Frame time of 1k, 10k and 100k small indexed draws, issued one by one with a uniform per draw against the draw
+/// batcher. Every frame ends with glFinish, so the time covers the CPU submission and the GPU execution. The context
+/// is created with a hidden window.
+auto main( ) -> int
+{
+    if(GLFW_FALSE == glfwInit( ))
+    {
+        std::cout << "Failed to initialize GLFW.\n";
+        return -1;
+    }
+
+    int returnCode{ };
+    try
+    {
+        run( );
+    }
+    catch(std::exception const & e)
+    {
+        std::cout << e.what( ) << '\n';
+        returnCode = -1;
+    }
+    glfwTerminate( );
+    return returnCode;
+}
@@ -0,0 +1,104 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "benchmark.hpp"
+#include "indexNarrowing.hpp"
+
+#include "fmt/core.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t k_numIndices{16 * 1024 * 1024};
+
+template<typename TIndex>
+auto makeIndices(GLuint const maxIndex) -> std::vector<TIndex>
+{
+    std::mt19937                          generator{42};
+    std::uniform_int_distribution<GLuint> distribution{0, maxIndex};
+
+    std::vector<TIndex> indices(k_numIndices);
+    std::generate(indices.begin( ), indices.end( ), [&]( ) { return static_cast<TIndex>(distribution(generator)); });
+    return indices;
+}
+
+template<typename TIndex>
+auto benchmarkMaxIndex(char const * const typeName, std::vector<TIndex> const & indices) -> void
+{
+    std::size_t const numBytes{indices.size( ) * sizeof(TIndex)};
+
+    printThroughput(fmt::format("max of {} indices, std::max_element", typeName), numBytes, measure([&]( ) {
+        doNotOptimize(*std::max_element(indices.begin( ), indices.end( )));
+    }));
+    printThroughput(fmt::format("max of {} indices, getMaxIndex", typeName), numBytes, measure([&]( ) {
+        doNotOptimize(getMaxIndex(indices.data( ), indices.size( ), false));
+    }));
+    printThroughput(fmt::format("max of {} indices, getMaxIndex with restart", typeName), numBytes, measure([&]( ) {
+        doNotOptimize(getMaxIndex(indices.data( ), indices.size( ), true));
+    }));
+}
+
+template<typename TTarget, typename TSource>
+auto benchmarkNarrowing(char const * const name, std::vector<TSource> const & indices) -> void
+{
+    std::size_t const numBytes{indices.size( ) * sizeof(TSource)};
+
+    printThroughput(fmt::format("{}, std::transform", name), numBytes, measure([&]( ) {
+        std::vector<TTarget> narrowed(indices.size( ));
+        std::transform(indices.begin( ), indices.end( ), narrowed.begin( ), [](TSource const index) {
+            return static_cast<TTarget>(index);
+        });
+        doNotOptimize(narrowed.data( ));
+    }));
+    printThroughput(fmt::format("{}, narrowIndices", name), numBytes, measure([&]( ) {
+        doNotOptimize(narrowIndices<TTarget>(indices.data( ), indices.size( ), false).data( ));
+    }));
+    printThroughput(fmt::format("{}, narrowIndices with restart", name), numBytes, measure([&]( ) {
+        doNotOptimize(narrowIndices<TTarget>(indices.data( ), indices.size( ), true).data( ));
+    }));
+}
+}
+
+/// Throughput of the largest index scan and of the narrowing of index buffers, in bytes of source indices per second.
+auto main( ) -> int
+{
+    std::vector<GLuint> const   indices32{makeIndices<GLuint>(60'000)};
+    std::vector<GLushort> const indices16{makeIndices<GLushort>(250)};
+    std::vector<GLubyte> const  indices8{makeIndices<GLubyte>(250)};
+
+    fmt::print("{} indices per run\n", k_numIndices);
+    benchmarkMaxIndex("32-bit", indices32);
+    benchmarkMaxIndex("16-bit", indices16);
+    benchmarkMaxIndex("8-bit", indices8);
+    benchmarkNarrowing<GLushort>("32-bit to 16-bit", indices32);
+    benchmarkNarrowing<GLubyte>("16-bit to 8-bit", indices16);
+    return 0;
+}
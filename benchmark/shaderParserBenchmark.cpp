@@ -0,0 +1,109 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "benchmark.hpp"
+#include "shaderParser.hpp"
+
+#include "fmt/core.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+// The parser before the mapped scanner, line by line with std::getline into string streams
+auto parseWithGetline(std::filesystem::path const & shaderFilePath) -> std::array<std::string, 2>
+{
+    std::ifstream                    shaderFile(shaderFilePath);
+    std::string                      line{ };
+    std::size_t                      stage{ };
+    std::array<std::stringstream, 2> shaderTexts{ };
+
+    while(std::getline(shaderFile, line))
+    {
+        if(std::string::npos != line.find("// shader vertex"))
+        {
+            stage = 0;
+            continue;
+        }
+        if(std::string::npos != line.find("// shader fragment"))
+        {
+            stage = 1;
+            continue;
+        }
+        shaderTexts.at(stage) << line << '\n';
+    }
+    return {shaderTexts.at(0).str( ), shaderTexts.at(1).str( )};
+}
+
+// A vertex and a fragment stage of the given number of lines each, without includes the old parser would not resolve
+auto writeShaderFile(std::filesystem::path const & shaderFilePath, std::size_t const numLinesPerStage) -> std::size_t
+{
+    std::ofstream shaderFile(shaderFilePath, std::ios::binary);
+    for(char const * const stage : {"vertex", "fragment"})
+    {
+        shaderFile << "// shader " << stage << "\n#version 330 core\n\n";
+        for(std::size_t line{ }; line < numLinesPerStage; ++line)
+        {
+            shaderFile << "    vec4 value" << line << " = texture(u_sampler, v_texCoord * " << line << ".0);\n";
+        }
+    }
+    shaderFile.close( );
+    return static_cast<std::size_t>(std::filesystem::file_size(shaderFilePath));
+}
+
+auto benchmarkParsers(std::filesystem::path const & shaderFilePath, std::size_t const numLinesPerStage) -> void
+{
+    std::size_t const numBytes{writeShaderFile(shaderFilePath, numLinesPerStage)};
+
+    printThroughput(fmt::format("{} lines per stage, std::getline", numLinesPerStage), numBytes, measure([&]( ) {
+        doNotOptimize(parseWithGetline(shaderFilePath).at(1).data( ));
+    }));
+    printThroughput(fmt::format("{} lines per stage, CShaderParser", numLinesPerStage), numBytes, measure([&]( ) {
+        CShaderParser parser{ };
+        parser.parse(shaderFilePath);
+        doNotOptimize(parser.getFragmentShaderSource( ).data( ));
+    }));
+}
+}
+
+/// Parse throughput of the mapped scanner against the former std::getline parser, in bytes of shader files per second.
+/// Both read the file from the page cache after the first run.
+auto main( ) -> int
+{
+    std::filesystem::path const shaderFilePath{std::filesystem::temp_directory_path( ) / "learnogl-benchmark.shader"};
+
+    // A typical shader file and one of generated code
+    benchmarkParsers(shaderFilePath, 100);
+    benchmarkParsers(shaderFilePath, 100'000);
+
+    std::filesystem::remove(shaderFilePath);
+    return 0;
+}
@@ -0,0 +1,115 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "benchmark.hpp"
+#include "vertexInterleaver.hpp"
+
+#include "fmt/core.h"
+
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t k_numVertices{2 * 1024 * 1024};
+
+struct CStream
+{
+    std::vector<std::byte> m_data{ };
+    CVertexBufferLayout    m_layout{ };
+};
+
+auto makeStream(EVertexAttributeIndex const index, ENumberOfComponents const numComponents) -> CStream
+{
+    CStream stream{ };
+    stream.m_layout.addFloat(index, numComponents);
+    stream.m_data.resize(k_numVertices * static_cast<std::size_t>(stream.m_layout.getStride( )));
+    std::iota(
+        reinterpret_cast<unsigned char*>(stream.m_data.data( )),
+        reinterpret_cast<unsigned char*>(stream.m_data.data( ) + stream.m_data.size( )), static_cast<unsigned char>(0));
+    return stream;
+}
+
+// Copies every vertex of every stream with a memcpy of a runtime size into a new buffer, the baseline
+auto interleaveScalar(std::vector<CStream> const & streams, std::size_t const stride) -> std::vector<std::byte>
+{
+    std::vector<std::byte> destination(k_numVertices * stride);
+    std::size_t            offset{ };
+    for(CStream const & stream : streams)
+    {
+        std::size_t const size{static_cast<std::size_t>(stream.m_layout.getStride( ))};
+        for(std::size_t i{ }; i < k_numVertices; ++i)
+        {
+            std::memcpy(destination.data( ) + (i * stride) + offset, stream.m_data.data( ) + (i * size), size);
+        }
+        offset += size;
+    }
+    return destination;
+}
+}
+
+/// Throughput of the interleaver for positions, normals, texture coordinates and a scalar attribute, in bytes of
+/// vertices per second.
+auto main( ) -> int
+{
+    std::vector<CStream> const streams{
+        makeStream(EVertexAttributeIndex::Zero, ENumberOfComponents::Three),
+        makeStream(EVertexAttributeIndex::One, ENumberOfComponents::Three),
+        makeStream(EVertexAttributeIndex::Two, ENumberOfComponents::Two),
+        makeStream(EVertexAttributeIndex::Three, ENumberOfComponents::One)};
+
+    std::vector<CVertexStream> vertexStreams{ };
+    std::size_t                stride{ };
+    for(CStream const & stream : streams)
+    {
+        vertexStreams.push_back({stream.m_data.data( ), &stream.m_layout});
+        stride += static_cast<std::size_t>(stream.m_layout.getStride( ));
+    }
+    std::size_t const numBytes{k_numVertices * stride};
+
+    // Both allocate the interleaved buffer, as the interleaver has to
+    std::vector<std::byte> destination{ };
+    printThroughput("interleave, scalar", numBytes, measure([&]( ) {
+        destination = interleaveScalar(streams, stride);
+        doNotOptimize(destination.data( ));
+    }));
+
+    CInterleavedVertices interleaved{ };
+    printThroughput("interleave, CVertexInterleaver", numBytes, measure([&]( ) {
+        interleaved = CVertexInterleaver::interleave(vertexStreams, k_numVertices);
+        doNotOptimize(interleaved.m_data.data( ));
+    }));
+    fmt::print("Interleaved vertices match: {}\n", interleaved.m_data == destination);
+
+    printThroughput("deinterleave, CVertexInterleaver", numBytes, measure([&]( ) {
+        std::vector<std::vector<std::byte>> const deinterleaved{
+            CVertexInterleaver::deinterleave(interleaved.m_data.data( ), interleaved.m_layout, k_numVertices)};
+        doNotOptimize(deinterleaved.data( ));
+    }));
+    return 0;
+}
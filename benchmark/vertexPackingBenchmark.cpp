@@ -0,0 +1,109 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "benchmark.hpp"
+#include "vertexPacking.hpp"
+
+#include "fmt/core.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t k_numFloats{16 * 1024 * 1024};
+
+// Straightforward conversions, the baseline of the packers
+template<typename TTarget>
+auto packSnormScalar(float const * const source, std::size_t const count, TTarget* const destination) -> void
+{
+    constexpr float k_scale{static_cast<float>(std::numeric_limits<TTarget>::max( ))};
+    for(std::size_t i{ }; i < count; ++i)
+    {
+        destination[i] = static_cast<TTarget>(std::lround(std::clamp(source[i], -1.0F, 1.0F) * k_scale));
+    }
+}
+
+template<typename TTarget>
+auto packUnormScalar(float const * const source, std::size_t const count, TTarget* const destination) -> void
+{
+    constexpr float k_scale{static_cast<float>(std::numeric_limits<TTarget>::max( ))};
+    for(std::size_t i{ }; i < count; ++i)
+    {
+        destination[i] = static_cast<TTarget>(std::lround(std::clamp(source[i], 0.0F, 1.0F) * k_scale));
+    }
+}
+
+auto packHalfFloatsScalar(float const * const source, std::size_t const count, CHalfFloat* const destination) -> void
+{
+    std::transform(source, source + count, destination, toHalfFloat);
+}
+
+template<typename TTarget, typename TPacker>
+auto benchmarkPacker(char const * const name, std::vector<float> const & source, TPacker&& packer) -> void
+{
+    std::vector<TTarget> destination(source.size( ));
+    printThroughput(name, source.size( ) * sizeof(float), measure([&]( ) {
+        packer(source.data( ), source.size( ), destination.data( ));
+        doNotOptimize(destination.data( ));
+    }));
+}
+}
+
+/// Throughput of the vertex attribute packers against scalar conversions, in bytes of source floats per second.
+auto main( ) -> int
+{
+    std::mt19937                          generator{42};
+    std::uniform_real_distribution<float> distribution{-1.5F, 1.5F};
+
+    std::vector<float> source(k_numFloats);
+    std::generate(source.begin( ), source.end( ), [&]( ) { return distribution(generator); });
+
+    fmt::print("{} floats per run\n", k_numFloats);
+    benchmarkPacker<CHalfFloat>("half float, scalar", source, packHalfFloatsScalar);
+    benchmarkPacker<CHalfFloat>("half float, packHalfFloats", source, packHalfFloats);
+    benchmarkPacker<GLbyte>("snorm8, scalar", source, packSnormScalar<GLbyte>);
+    benchmarkPacker<GLbyte>("snorm8, packSnorm8", source, packSnorm8);
+    benchmarkPacker<GLubyte>("unorm8, scalar", source, packUnormScalar<GLubyte>);
+    benchmarkPacker<GLubyte>("unorm8, packUnorm8", source, packUnorm8);
+    benchmarkPacker<GLshort>("snorm16, scalar", source, packSnormScalar<GLshort>);
+    benchmarkPacker<GLshort>("snorm16, packSnorm16", source, packSnorm16);
+    benchmarkPacker<GLushort>("unorm16, scalar", source, packUnormScalar<GLushort>);
+    benchmarkPacker<GLushort>("unorm16, packUnorm16", source, packUnorm16);
+
+    // Three components per vector, as normals
+    std::size_t const           numVectors{source.size( ) / 3};
+    std::vector<CInt2101010Rev> vectors(numVectors);
+    printThroughput("int 2-10-10-10 of vec3, packInt2101010Rev", numVectors * 3 * sizeof(float), measure([&]( ) {
+        packInt2101010Rev(source.data( ), numVectors, 3, vectors.data( ));
+        doNotOptimize(vectors.data( ));
+    }));
+    return 0;
+}
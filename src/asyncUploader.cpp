@@ -0,0 +1,359 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "asyncUploader.hpp"
+#include "vertexBuffer.hpp"
+#include "stateAccess.hpp"
+#include "error.hpp"
+
+#include "GLFW/glfw3.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+struct CAsyncUpload
+{
+    std::vector<std::byte>  m_data{ };
+    GLsizeiptr              m_size{ };
+    EBufferUsagePattern     m_usage{ };
+    GLuint                  m_bufferId{ };
+    GLsync                  m_fence{ };
+    std::exception_ptr      m_error{ };
+    std::atomic<bool>       m_isReady{ };
+    std::mutex              m_mutex{ };
+    std::condition_variable m_condition{ };
+};
+
+namespace
+{
+// The loader thread polls the fences of the uploads in flight at this interval while no new uploads arrive
+constexpr std::chrono::milliseconds k_pollInterval{1};
+constexpr GLuint64                  k_shutdownTimeout{1'000'000'000};
+
+auto complete(CAsyncUpload& upload) -> void
+{
+    {
+        std::lock_guard<std::mutex> const lock{upload.m_mutex};
+        upload.m_isReady = true;
+    }
+    upload.m_condition.notify_all( );
+}
+
+auto fail(CAsyncUpload& upload, std::exception_ptr const error) -> void
+{
+    upload.m_error = error;
+    complete(upload);
+}
+
+// Deletes the buffers of completed uploads whose handles are gone, nobody can take them anymore
+auto deleteAbandoned(std::vector<std::shared_ptr<CAsyncUpload>>& uploads) -> void
+{
+    auto const isAbandoned{[](std::shared_ptr<CAsyncUpload> const & upload) {
+        if(upload.use_count( ) > 1)
+        {
+            return false;
+        }
+        GLuint const bufferId{std::exchange(upload->m_bufferId, { })};
+        if(0 != bufferId)
+        {
+            GLCheck(glDeleteBuffers(1, &bufferId));
+        }
+        return true;
+    }};
+    uploads.erase(std::remove_if(uploads.begin( ), uploads.end( ), isAbandoned), uploads.end( ));
+}
+
+// Deletes the buffers that were never taken when the loader thread stops, their handles report the shutdown. The loader
+// thread is about to exit, so the errors of GL are not checked.
+auto deleteUntaken(std::vector<std::shared_ptr<CAsyncUpload>>& uploads) -> void
+{
+    for(std::shared_ptr<CAsyncUpload> const & upload : uploads)
+    {
+        std::lock_guard<std::mutex> const lock{upload->m_mutex};
+        if(nullptr != upload->m_fence)
+        {
+            glDeleteSync(upload->m_fence);
+            upload->m_fence = { };
+        }
+
+        GLuint const bufferId{std::exchange(upload->m_bufferId, { })};
+        if(0 == bufferId)
+        {
+            continue;
+        }
+        glDeleteBuffers(1, &bufferId);
+        if(nullptr == upload->m_error)
+        {
+            upload->m_error = std::make_exception_ptr(
+                std::runtime_error("The asynchronous uploader stopped before the buffer was taken."));
+        }
+    }
+    uploads.clear( );
+}
+}
+
+auto CUploadHandle::isValid( ) const -> bool
+{
+    return nullptr != m_upload;
+}
+
+auto CUploadHandle::isReady( ) const -> bool
+{
+    return (nullptr != m_upload) && m_upload->m_isReady;
+}
+
+auto CUploadHandle::wait( ) const -> void
+{
+    if(nullptr == m_upload)
+    {
+        throw std::runtime_error("The upload handle has no upload.");
+    }
+
+    std::unique_lock<std::mutex> lock{m_upload->m_mutex};
+    m_upload->m_condition.wait(lock, [this] { return m_upload->m_isReady.load( ); });
+}
+
+auto CUploadHandle::take( ) -> GLuint
+{
+    wait( );
+
+    std::shared_ptr<CAsyncUpload> const upload{std::exchange(m_upload, { })};
+    std::lock_guard<std::mutex> const   lock{upload->m_mutex};
+    if(nullptr != upload->m_error)
+    {
+        std::rethrow_exception(upload->m_error);
+    }
+    return std::exchange(upload->m_bufferId, { });
+}
+
+CAsyncUploader::~CAsyncUploader( )
+{
+    destroy( );
+}
+
+auto CAsyncUploader::create(GLFWwindow* const sharedWindow) -> void
+{
+    destroy( );
+
+    // The hints of the render context still apply, the loader context gets the same version and profile
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    m_window = glfwCreateWindow(1, 1, "Loader", nullptr, sharedWindow);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    if(nullptr == m_window)
+    {
+        throw std::runtime_error("Failed to create the shared context of the loader thread.");
+    }
+
+    m_thread = std::thread{&CAsyncUploader::run, this};
+}
+
+auto CAsyncUploader::destroy( ) -> void
+{
+    if(nullptr == m_window)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        m_isStopping = true;
+    }
+    m_condition.notify_all( );
+    m_thread.join( );
+
+    glfwDestroyWindow(m_window);
+    m_window     = { };
+    m_isStopping = false;
+    m_error      = { };
+}
+
+auto CAsyncUploader::upload(GLvoid const * const data, GLsizeiptr const size, EBufferUsagePattern const usage)
+    -> CUploadHandle
+{
+    if(nullptr == m_window)
+    {
+        throw std::runtime_error("The asynchronous uploader has no loader thread.");
+    }
+
+    std::shared_ptr<CAsyncUpload> const upload{std::make_shared<CAsyncUpload>( )};
+    upload->m_size  = size;
+    upload->m_usage = usage;
+    if(nullptr != data)
+    {
+        upload->m_data.resize(static_cast<std::size_t>(size));
+        std::memcpy(upload->m_data.data( ), data, upload->m_data.size( ));
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        if(nullptr != m_error)
+        {
+            fail(*upload, m_error);
+        }
+        else
+        {
+            m_queue.push_back(upload);
+        }
+    }
+    m_condition.notify_one( );
+
+    CUploadHandle handle{ };
+    handle.m_upload = upload;
+    return handle;
+}
+
+auto CAsyncUploader::getNumQueued( ) const -> std::size_t
+{
+    std::lock_guard<std::mutex> const lock{m_mutex};
+    return m_queue.size( );
+}
+
+auto CAsyncUploader::run( ) -> void
+{
+    glfwMakeContextCurrent(m_window);
+
+    std::vector<std::shared_ptr<CAsyncUpload>> uploads{ };
+    std::vector<std::shared_ptr<CAsyncUpload>> inFlight{ };
+    std::vector<std::shared_ptr<CAsyncUpload>> completed{ };
+
+    try
+    {
+        bool isStopping{ };
+        while(!isStopping || !inFlight.empty( ))
+        {
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                auto const                   hasWork{[this] { return m_isStopping || !m_queue.empty( ); }};
+                if(inFlight.empty( ))
+                {
+                    m_condition.wait(lock, hasWork);
+                }
+                else
+                {
+                    m_condition.wait_for(lock, k_pollInterval, hasWork);
+                }
+                isStopping = m_isStopping;
+                uploads.assign(m_queue.begin( ), m_queue.end( ));
+                m_queue.clear( );
+            }
+
+            for(std::shared_ptr<CAsyncUpload>& upload : uploads)
+            {
+                process(*upload);
+                (nullptr == upload->m_error ? inFlight : completed).push_back(std::move(upload));
+            }
+            uploads.clear( );
+
+            // The queued uploads are finished before the loader thread stops
+            GLuint64 const timeout{isStopping ? k_shutdownTimeout : GLuint64{ }};
+            for(std::shared_ptr<CAsyncUpload>& upload : inFlight)
+            {
+                (poll(*upload, timeout) ? completed : uploads).push_back(std::move(upload));
+            }
+            inFlight.swap(uploads);
+            uploads.clear( );
+
+            deleteAbandoned(completed);
+        }
+    }
+    catch(std::exception const & e)
+    {
+        spdlog::error("The loader thread stopped: {}", e.what( ));
+
+        // The loops move the uploads from one list to the next, the error may leave any list partly moved. Every
+        // upload that has not completed fails, the moved from entries are empty.
+        std::exception_ptr const error{std::current_exception( )};
+        auto const               failPending{[&completed, error](auto& pending) {
+            for(std::shared_ptr<CAsyncUpload>& upload : pending)
+            {
+                if(nullptr != upload)
+                {
+                    fail(*upload, error);
+                    completed.push_back(std::move(upload));
+                }
+            }
+            pending.clear( );
+        }};
+
+        failPending(uploads);
+        failPending(inFlight);
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        failPending(m_queue);
+        m_error = error;
+    }
+
+    deleteUntaken(completed);
+    glfwMakeContextCurrent(nullptr);
+}
+
+auto CAsyncUploader::process(CAsyncUpload& upload) const -> void
+{
+    try
+    {
+        CVertexBuffer buffer{ };
+        buffer.create(upload.m_data.empty( ) ? nullptr : upload.m_data.data( ), upload.m_size, 1, upload.m_usage);
+        if(!CStateAccess::isDirect( ))
+        {
+            // A name deleted by the render thread would stay bound in this context and could be handed out again
+            buffer.unbind( );
+        }
+
+        GLCheck(upload.m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        // The fence has to reach the driver before its status can change
+        GLCheck(glFlush( ));
+        upload.m_bufferId = buffer.release( );
+    }
+    catch(std::exception const &)
+    {
+        fail(upload, std::current_exception( ));
+    }
+    upload.m_data = { };
+}
+
+auto CAsyncUploader::poll(CAsyncUpload& upload, GLuint64 const timeout) const -> bool
+{
+    GLCheck(GLenum const status{glClientWaitSync(upload.m_fence, 0, timeout)});
+    if(GL_WAIT_FAILED == status)
+    {
+        throw std::runtime_error("Failed to wait for the fence of an upload.");
+    }
+    if(GL_TIMEOUT_EXPIRED == status)
+    {
+        return false;
+    }
+
+    GLCheck(glDeleteSync(upload.m_fence));
+    upload.m_fence = { };
+    complete(upload);
+    return true;
+}
@@ -0,0 +1,112 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "bufferUsagePattern.hpp"
+
+#include "glad/glad.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct GLFWwindow;
+
+struct CAsyncUpload;
+
+/// Result of an asynchronous upload, comparable to a std::future of the buffer name.
+///
+/// The handle is ready once the fence behind the upload has signalled. The buffer belongs to the share group of the
+/// render context and is taken over with CVertexBuffer::adopt or CIndexBuffer::adopt. A buffer that is never taken is
+/// deleted by the loader thread once the last handle is gone.
+class CUploadHandle
+{
+public:
+    auto isValid( ) const -> bool;
+    /// Never blocks, true once the upload has completed or failed.
+    auto isReady( ) const -> bool;
+    auto wait( ) const -> void;
+
+    /// Buffer name of the completed upload, rethrows the error of a failed upload.
+    auto take( ) -> GLuint;
+
+private:
+    friend class CAsyncUploader;
+
+    std::shared_ptr<CAsyncUpload> m_upload{ };
+};
+
+/// Uploads buffer data on a loader thread with its own OpenGL context, shared with the context of the render thread.
+///
+/// The loader context belongs to a hidden window, which also works on headless drivers like llvmpipe. Every upload is
+/// followed by a fence, the loader thread polls the fences between the uploads and marks the handles as ready.
+class CAsyncUploader
+{
+public:
+    CAsyncUploader( ) = default;
+    ~CAsyncUploader( );
+
+    CAsyncUploader(CAsyncUploader const & other)            = delete;
+    CAsyncUploader& operator=(CAsyncUploader const & other) = delete;
+
+    CAsyncUploader(CAsyncUploader&& other)                  = delete;
+    CAsyncUploader& operator=(CAsyncUploader&& other)       = delete;
+
+public:
+    /// Creates the loader context. GLFW allows windows on the main thread only, the same applies to destroy( ).
+    auto create(GLFWwindow* const sharedWindow) -> void;
+    auto destroy( ) -> void;
+
+    /// Copies the data and queues the upload into a new buffer. Once the loader thread stopped on an error, the upload
+    /// fails with that error.
+    auto upload(
+        GLvoid const * const      data,
+        GLsizeiptr const          size,
+        EBufferUsagePattern const usage = EBufferUsagePattern::StaticDraw) -> CUploadHandle;
+
+    auto getNumQueued( ) const -> std::size_t;
+
+private:
+    auto run( ) -> void;
+    auto process(CAsyncUpload& upload) const -> void;
+    auto poll(CAsyncUpload& upload, GLuint64 const timeout) const -> bool;
+
+private:
+    GLFWwindow*                               m_window{ };
+    std::thread                               m_thread{ };
+    mutable std::mutex                        m_mutex{ };
+    std::condition_variable                   m_condition{ };
+    std::deque<std::shared_ptr<CAsyncUpload>> m_queue{ };
+    bool                                      m_isStopping{ };
+    std::exception_ptr                        m_error{ };
+};
@@ -0,0 +1,286 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "bufferArena.hpp"
+#include "error.hpp"
+#include "stateCache.hpp"
+#include "stateAccess.hpp"
+
+#include "fmt/core.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+auto getFragmentation(std::uint32_t const totalFree, std::uint32_t const largestFree) -> float
+{
+    return (0 == totalFree) ? 0.0F : 1.0F - (static_cast<float>(largestFree) / static_cast<float>(totalFree));
+}
+
+auto copyBufferSubData(
+    GLuint const     readBuffer,
+    GLuint const     writeBuffer,
+    GLintptr const   readOffset,
+    GLintptr const   writeOffset,
+    GLsizeiptr const size) -> void
+{
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glCopyNamedBufferSubData(readBuffer, writeBuffer, readOffset, writeOffset, size));
+    }
+    else
+    {
+        CStateCache::get( ).bindBuffer(GL_COPY_READ_BUFFER, readBuffer);
+        CStateCache::get( ).bindBuffer(GL_COPY_WRITE_BUFFER, writeBuffer);
+        GLCheck(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, readOffset, writeOffset, size));
+    }
+}
+
+// Packs the allocations of one buffer to its start. A buffer range can not be copied onto an overlapping range of the
+// same buffer, the allocations are therefore gathered in a scratch buffer first and copied back with a single call.
+template<typename TSlot>
+auto compact(
+    std::vector<TSlot>&                  slots,
+    COffsetAllocator::CAllocation TSlot::*allocation,
+    std::uint32_t TSlot::*               count,
+    COffsetAllocator&                    allocator,
+    GLuint const                         bufferId,
+    GLsizeiptr const                     unitSize) -> std::uint32_t
+{
+    std::vector<TSlot*> liveSlots{ };
+    std::uint32_t       numUsed{ };
+    for(TSlot& slot : slots)
+    {
+        if(COffsetAllocator::k_invalidOffset != (slot.*allocation).m_node)
+        {
+            liveSlots.push_back(&slot);
+            numUsed += slot.*count;
+        }
+    }
+    std::sort(liveSlots.begin( ), liveSlots.end( ), [allocation](TSlot const * const lhs, TSlot const * const rhs) {
+        return (lhs->*allocation).m_offset < (rhs->*allocation).m_offset;
+    });
+
+    std::uint32_t numMoved{ };
+    if(0 < numUsed)
+    {
+        CVertexBuffer scratchBuffer{ };
+        scratchBuffer.create(nullptr, unitSize, numUsed, EBufferUsagePattern::StreamCopy);
+
+        std::uint32_t packedOffset{ };
+        for(TSlot const * const slot : liveSlots)
+        {
+            std::uint32_t const offset{(slot->*allocation).m_offset};
+            numMoved += (offset != packedOffset) ? (slot->*count) : 0;
+
+            copyBufferSubData(
+                bufferId, scratchBuffer.getId( ), unitSize * offset, unitSize * packedOffset,
+                unitSize * (slot->*count));
+            packedOffset += slot->*count;
+        }
+        copyBufferSubData(scratchBuffer.getId( ), bufferId, 0, 0, unitSize * numUsed);
+    }
+
+    // A fresh allocator hands out consecutive ranges from the start, in the order of the copies above
+    allocator.create(allocator.getSize( ));
+    for(TSlot* const slot : liveSlots)
+    {
+        slot->*allocation = allocator.allocate(slot->*count);
+    }
+    return numMoved;
+}
+}
+
+auto CBufferArena::CStatistics::getVertexFragmentation( ) const -> float
+{
+    return getFragmentation(m_vertexCapacity - m_usedVertices, m_largestFreeVertices);
+}
+
+auto CBufferArena::CStatistics::getIndexFragmentation( ) const -> float
+{
+    return getFragmentation(m_indexCapacity - m_usedIndices, m_largestFreeIndices);
+}
+
+auto CBufferArena::create(
+    GLsizei const vertexStride, std::uint32_t const vertexCapacity, std::uint32_t const indexCapacity) -> void
+{
+    destroy( );
+
+    m_vertexStride = vertexStride;
+    m_vertexBuffer.create(nullptr, vertexStride, vertexCapacity, EBufferUsagePattern::DynamicDraw);
+    m_indexBuffer.create(static_cast<GLuint const *>(nullptr), indexCapacity, EBufferUsagePattern::DynamicDraw);
+    m_vertexAllocator.create(vertexCapacity);
+    m_indexAllocator.create(indexCapacity);
+}
+
+auto CBufferArena::destroy( ) -> void
+{
+    m_vertexBuffer.destroy( );
+    m_indexBuffer.destroy( );
+    m_vertexAllocator = { };
+    m_indexAllocator  = { };
+    m_slots.clear( );
+    m_freeHandles.clear( );
+    m_vertexStride = { };
+}
+
+auto CBufferArena::allocate(
+    GLvoid const * const vertices,
+    std::uint32_t const  numVertices,
+    GLuint const * const indices,
+    std::uint32_t const  numIndices) -> Handle
+{
+    if(0 == numVertices)
+    {
+        throw std::runtime_error("A buffer arena allocation requires at least one vertex.");
+    }
+
+    CSlot slot{ };
+    slot.m_numVertices = numVertices;
+    slot.m_numIndices  = numIndices;
+
+    slot.m_vertices = m_vertexAllocator.allocate(numVertices);
+    if(COffsetAllocator::k_invalidOffset == slot.m_vertices.m_offset)
+    {
+        throw std::runtime_error(fmt::format(
+            "The buffer arena has no free range of {} vertices, {} of {} are free.", numVertices,
+            m_vertexAllocator.getStorageReport( ).m_totalFree, m_vertexAllocator.getSize( )));
+    }
+
+    if(0 < numIndices)
+    {
+        slot.m_indices = m_indexAllocator.allocate(numIndices);
+        if(COffsetAllocator::k_invalidOffset == slot.m_indices.m_offset)
+        {
+            m_vertexAllocator.free(slot.m_vertices);
+            throw std::runtime_error(fmt::format(
+                "The buffer arena has no free range of {} indices, {} of {} are free.", numIndices,
+                m_indexAllocator.getStorageReport( ).m_totalFree, m_indexAllocator.getSize( )));
+        }
+    }
+
+    if(nullptr != vertices)
+    {
+        m_vertexBuffer.update(
+            static_cast<GLintptr>(slot.m_vertices.m_offset) * m_vertexStride, vertices,
+            static_cast<GLsizeiptr>(numVertices) * m_vertexStride);
+    }
+    if((nullptr != indices) && (0 < numIndices))
+    {
+        m_indexBuffer.update(slot.m_indices.m_offset, indices, numIndices);
+    }
+
+    if(!m_freeHandles.empty( ))
+    {
+        Handle const handle{m_freeHandles.back( )};
+        m_freeHandles.pop_back( );
+        m_slots.at(handle) = slot;
+        return handle;
+    }
+    m_slots.push_back(slot);
+    return static_cast<Handle>(m_slots.size( ) - 1);
+}
+
+auto CBufferArena::free(Handle const handle) -> void
+{
+    CSlot& slot{m_slots.at(handle)};
+    if(COffsetAllocator::k_invalidOffset == slot.m_vertices.m_node)
+    {
+        throw std::runtime_error(fmt::format("The buffer arena handle {} is not allocated.", handle));
+    }
+
+    m_vertexAllocator.free(slot.m_vertices);
+    m_indexAllocator.free(slot.m_indices);
+    slot = { };
+    m_freeHandles.push_back(handle);
+}
+
+auto CBufferArena::getAllocation(Handle const handle) const -> CAllocation
+{
+    CSlot const & slot{getSlot(handle)};
+    GLintptr const indexOffset{
+        (0 < slot.m_numIndices) ? static_cast<GLintptr>(sizeof(GLuint) * slot.m_indices.m_offset) : 0};
+    return {
+        static_cast<GLint>(slot.m_vertices.m_offset), static_cast<GLsizei>(slot.m_numVertices), indexOffset,
+        static_cast<GLsizei>(slot.m_numIndices)};
+}
+
+auto CBufferArena::getVertexBuffer( ) const -> CVertexBuffer const &
+{
+    return m_vertexBuffer;
+}
+
+auto CBufferArena::getIndexBuffer( ) const -> CIndexBuffer const &
+{
+    return m_indexBuffer;
+}
+
+auto CBufferArena::getStatistics( ) const -> CStatistics
+{
+    COffsetAllocator::CStorageReport const vertexReport{m_vertexAllocator.getStorageReport( )};
+    COffsetAllocator::CStorageReport const indexReport{m_indexAllocator.getStorageReport( )};
+
+    CStatistics statistics{ };
+    statistics.m_numAllocations       = vertexReport.m_numAllocations;
+    statistics.m_vertexCapacity       = m_vertexAllocator.getSize( );
+    statistics.m_usedVertices         = m_vertexAllocator.getSize( ) - vertexReport.m_totalFree;
+    statistics.m_largestFreeVertices  = vertexReport.m_largestFree;
+    statistics.m_numFreeVertexRegions = vertexReport.m_numFreeRegions;
+    statistics.m_indexCapacity        = m_indexAllocator.getSize( );
+    statistics.m_usedIndices          = m_indexAllocator.getSize( ) - indexReport.m_totalFree;
+    statistics.m_largestFreeIndices   = indexReport.m_largestFree;
+    statistics.m_numFreeIndexRegions  = indexReport.m_numFreeRegions;
+    return statistics;
+}
+
+auto CBufferArena::defragment( ) -> void
+{
+    CStatistics const before{getStatistics( )};
+
+    std::uint32_t const numMovedVertices{compact(
+        m_slots, &CSlot::m_vertices, &CSlot::m_numVertices, m_vertexAllocator, m_vertexBuffer.getId( ),
+        m_vertexStride)};
+    std::uint32_t const numMovedIndices{compact(
+        m_slots, &CSlot::m_indices, &CSlot::m_numIndices, m_indexAllocator, m_indexBuffer.getId( ),
+        sizeof(GLuint))};
+
+    spdlog::info(
+        "Buffer arena defragmented, {} vertices and {} indices moved, fragmentation {:.2f}/{:.2f} before.",
+        numMovedVertices, numMovedIndices, before.getVertexFragmentation( ), before.getIndexFragmentation( ));
+}
+
+auto CBufferArena::getSlot(Handle const handle) const -> CSlot const &
+{
+    CSlot const & slot{m_slots.at(handle)};
+    if(COffsetAllocator::k_invalidOffset == slot.m_vertices.m_node)
+    {
+        throw std::runtime_error(fmt::format("The buffer arena handle {} is not allocated.", handle));
+    }
+    return slot;
+}
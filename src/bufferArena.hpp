@@ -0,0 +1,117 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "offsetAllocator.hpp"
+#include "vertexBuffer.hpp"
+#include "indexBuffer.hpp"
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <vector>
+
+/// Shared vertex and index buffers that hold the data of many meshes.
+///
+/// The vertices are allocated in units of one vertex, the indices in units of one GLuint. A mesh is drawn with its base
+/// vertex and the byte offset of its indices, e.g. glDrawElementsBaseVertex, so the indices stay relative to the mesh.
+/// The buffers are never recreated, a vertex array set up once with getVertexBuffer( ) and getIndexBuffer( ) remains
+/// valid across defragment( ).
+class CBufferArena
+{
+public:
+    using Handle = std::uint32_t;
+
+    static constexpr Handle k_invalidHandle{~Handle{ }};
+
+    struct CAllocation
+    {
+        GLint    m_baseVertex{ };
+        GLsizei  m_numVertices{ };
+        GLintptr m_indexOffset{ };
+        GLsizei  m_numIndices{ };
+    };
+
+    struct CStatistics
+    {
+        std::uint32_t m_numAllocations{ };
+        std::uint32_t m_vertexCapacity{ };
+        std::uint32_t m_usedVertices{ };
+        std::uint32_t m_largestFreeVertices{ };
+        std::uint32_t m_numFreeVertexRegions{ };
+        std::uint32_t m_indexCapacity{ };
+        std::uint32_t m_usedIndices{ };
+        std::uint32_t m_largestFreeIndices{ };
+        std::uint32_t m_numFreeIndexRegions{ };
+
+        /// Share of the free space outside of the largest free region, 0 if the free space is contiguous.
+        auto getVertexFragmentation( ) const -> float;
+        auto getIndexFragmentation( ) const -> float;
+    };
+
+public:
+    auto create(GLsizei const vertexStride, std::uint32_t const vertexCapacity, std::uint32_t const indexCapacity)
+        -> void;
+    auto destroy( ) -> void;
+
+    auto allocate(
+        GLvoid const * const vertices,
+        std::uint32_t const  numVertices,
+        GLuint const * const indices,
+        std::uint32_t const  numIndices) -> Handle;
+    auto free(Handle const handle) -> void;
+
+    auto getAllocation(Handle const handle) const -> CAllocation;
+
+    auto getVertexBuffer( ) const -> CVertexBuffer const &;
+    auto getIndexBuffer( ) const -> CIndexBuffer const &;
+
+    auto getStatistics( ) const -> CStatistics;
+
+    auto defragment( ) -> void;
+
+private:
+    struct CSlot
+    {
+        COffsetAllocator::CAllocation m_vertices{ };
+        COffsetAllocator::CAllocation m_indices{ };
+        std::uint32_t                 m_numVertices{ };
+        std::uint32_t                 m_numIndices{ };
+    };
+
+    auto getSlot(Handle const handle) const -> CSlot const &;
+
+private:
+    GLsizei             m_vertexStride{ };
+    CVertexBuffer       m_vertexBuffer{ };
+    CIndexBuffer        m_indexBuffer{ };
+    COffsetAllocator    m_vertexAllocator{ };
+    COffsetAllocator    m_indexAllocator{ };
+    std::vector<CSlot>  m_slots{ };
+    std::vector<Handle> m_freeHandles{ };
+};
@@ -42,4 +42,17 @@ enum class EBufferUsagePattern : GLenum
     DynamicDraw = GL_DYNAMIC_DRAW,
     DynamicRead = GL_DYNAMIC_READ,
     DynamicCopy = GL_DYNAMIC_COPY,
-};
\ No newline at end of file
+};
+
+/// Flags of the immutable buffer storage that allow updates of the buffer data. The usage pattern is only a hint of
+/// glBufferData, the storage of every usage accepts the updates the mutable storage does.
+constexpr auto getUpdatableStorageFlags( ) -> GLbitfield
+{
+    return GL_DYNAMIC_STORAGE_BIT;
+}
+
+/// Size of the immutable buffer storage, glNamedBufferStorage rejects the empty storage glBufferData accepts.
+constexpr auto getBufferStorageSize(GLsizeiptr const size) -> GLsizeiptr
+{
+    return (0 < size) ? size : 1;
+}
\ No newline at end of file
@@ -0,0 +1,307 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "debugMessageQueue.hpp"
+#include "error.hpp"
+
+#include "fmt/core.h"
+#include "spdlog/spdlog.h"
+#include "spdlog/async.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+constexpr char const *              k_loggerName{"opengl"};
+constexpr std::chrono::seconds      k_repetitionWindow{1};
+constexpr std::chrono::milliseconds k_drainInterval{5};
+constexpr std::size_t               k_mask{CDebugMessageQueue::k_capacity - 1};
+
+static_assert(0 == (CDebugMessageQueue::k_capacity & k_mask), "The capacity has to be a power of two.");
+}
+
+CDebugMessageQueue::CDebugMessageQueue( )
+    : m_slots{std::make_unique<CSlot[]>(k_capacity)}
+{
+    for(std::size_t i{ }; i < k_capacity; ++i)
+    {
+        m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+
+    setEscalationSeverity(GL_DEBUG_SEVERITY_HIGH);
+    setRateLimit(GL_DEBUG_SEVERITY_HIGH, 100);
+    setRateLimit(GL_DEBUG_SEVERITY_MEDIUM, 20);
+    setRateLimit(GL_DEBUG_SEVERITY_LOW, 10);
+    setRateLimit(GL_DEBUG_SEVERITY_NOTIFICATION, 5);
+}
+
+CDebugMessageQueue::~CDebugMessageQueue( )
+{
+    stop( );
+}
+
+auto CDebugMessageQueue::start( ) -> void
+{
+    if(m_running.exchange(true))
+    {
+        return;
+    }
+
+    m_logger = spdlog::get(k_loggerName);
+    if(nullptr == m_logger)
+    {
+        m_logger = spdlog::create_async<spdlog::sinks::stdout_color_sink_mt>(k_loggerName);
+        m_logger->set_level(spdlog::level::debug);
+    }
+
+    m_thread = std::thread{&CDebugMessageQueue::drain, this};
+}
+
+auto CDebugMessageQueue::stop( ) -> void
+{
+    // The driver keeps the user pointer of the callback, which must not outlive the queue
+    CError::disableDebugOutput( );
+
+    if(!m_running.exchange(false))
+    {
+        return;
+    }
+
+    m_thread.join( );
+    m_logger->flush( );
+}
+
+auto CDebugMessageQueue::push(
+    GLenum const         source,
+    GLenum const         type,
+    GLuint const         id,
+    GLenum const         severity,
+    GLsizei const        length,
+    GLchar const * const message) noexcept -> bool
+{
+    std::size_t const messageLength{(length < 0) ? std::strlen(message) : static_cast<std::size_t>(length)};
+    std::size_t const copyLength{std::min(messageLength, CDebugMessage::k_maxLength)};
+
+    if(severityToRank(severity) >= m_escalationRank.load(std::memory_order_relaxed))
+    {
+        if(!m_escalationClaimed.exchange(true, std::memory_order_acquire))
+        {
+            m_escalationMessage = {source, type, id, severity, static_cast<std::uint32_t>(copyLength), { }};
+            std::memcpy(m_escalationMessage.m_message.data( ), message, copyLength);
+            m_escalationPending.store(true, std::memory_order_release);
+        }
+    }
+
+    CSlot*      slot{ };
+    std::size_t position{m_enqueuePosition.load(std::memory_order_relaxed)};
+    for(;;)
+    {
+        slot = &m_slots[position & k_mask];
+        std::size_t const    sequence{slot->m_sequence.load(std::memory_order_acquire)};
+        std::ptrdiff_t const difference{static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position)};
+
+        if(0 == difference)
+        {
+            if(m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if(difference < 0)
+        {
+            m_numDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->m_message = {source, type, id, severity, static_cast<std::uint32_t>(copyLength), { }};
+    std::memcpy(slot->m_message.m_message.data( ), message, copyLength);
+    slot->m_sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+auto CDebugMessageQueue::escalate( ) -> void
+{
+    if(!m_escalationPending.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    CDebugMessage const message{m_escalationMessage};
+    m_escalationPending.store(false, std::memory_order_relaxed);
+    m_escalationClaimed.store(false, std::memory_order_release);
+
+    throw std::runtime_error(fmt::format(
+        R"(Source: {}, Type: {}, Id: {}, Severity: {}, Message: "{}".)", CError::debugSourceToString(message.m_source),
+        CError::debugTypeToString(message.m_type), message.m_id, CError::debugSeverityToString(message.m_severity),
+        message.m_message.data( )));
+}
+
+auto CDebugMessageQueue::setEscalationSeverity(GLenum const severity) -> void
+{
+    m_escalationRank.store(severityToRank(severity), std::memory_order_relaxed);
+}
+
+auto CDebugMessageQueue::setRateLimit(GLenum const severity, std::uint32_t const messagesPerSecond) -> void
+{
+    CRateLimit& rateLimit{m_rateLimits.at(severityToRank(severity))};
+    rateLimit.m_messagesPerSecond = messagesPerSecond;
+    rateLimit.m_numTokens         = messagesPerSecond;
+}
+
+auto CDebugMessageQueue::getNumDropped( ) const -> std::uint64_t
+{
+    return m_numDropped.load(std::memory_order_relaxed);
+}
+
+auto CDebugMessageQueue::getNumSuppressed( ) const -> std::uint64_t
+{
+    return m_numSuppressed.load(std::memory_order_relaxed);
+}
+
+auto CDebugMessageQueue::severityToRank(GLenum const severity) -> std::size_t
+{
+    std::size_t rank{ };
+    // clang-format off
+    switch(severity)
+    {
+    case GL_DEBUG_SEVERITY_NOTIFICATION:    rank = 0; break;
+    case GL_DEBUG_SEVERITY_LOW:             rank = 1; break;
+    case GL_DEBUG_SEVERITY_MEDIUM:          rank = 2; break;
+    case GL_DEBUG_SEVERITY_HIGH:            rank = 3; break;
+    }
+    // clang-format on
+    return rank;
+}
+
+auto CDebugMessageQueue::pop(CDebugMessage& message) -> bool
+{
+    CSlot&            slot{m_slots[m_dequeuePosition & k_mask]};
+    std::size_t const sequence{slot.m_sequence.load(std::memory_order_acquire)};
+    if(sequence != m_dequeuePosition + 1)
+    {
+        return false;
+    }
+
+    message = slot.m_message;
+    slot.m_sequence.store(m_dequeuePosition + k_capacity, std::memory_order_release);
+    ++m_dequeuePosition;
+    return true;
+}
+
+auto CDebugMessageQueue::drain( ) -> void
+{
+    CDebugMessage message{ };
+
+    // Keep draining after stop( ) until the queue is empty.
+    for(bool running{true}; running;)
+    {
+        running = m_running.load(std::memory_order_acquire);
+
+        while(pop(message))
+        {
+            process(message);
+        }
+
+        std::uint64_t const numDropped{m_numDropped.load(std::memory_order_relaxed)};
+        if(numDropped != m_numDroppedReported)
+        {
+            m_logger->warn("{} OpenGL debug messages dropped, the queue was full.", numDropped - m_numDroppedReported);
+            m_numDroppedReported = numDropped;
+        }
+
+        if(running)
+        {
+            std::this_thread::sleep_for(k_drainInterval);
+        }
+    }
+}
+
+auto CDebugMessageQueue::process(CDebugMessage const & message) -> void
+{
+    auto const now{std::chrono::steady_clock::now( )};
+
+    // Drop the repetitions of a message within the repetition window.
+    std::uint64_t const key{
+        (static_cast<std::uint64_t>(message.m_source & 0xFFFF) << 48) |
+        (static_cast<std::uint64_t>(message.m_type & 0xFFFF) << 32) | message.m_id};
+    auto const [iter, inserted]{m_repetitions.try_emplace(key)};
+    CRepetition& repetition{iter->second};
+    if(!inserted && (now - repetition.m_lastLogged < k_repetitionWindow))
+    {
+        ++repetition.m_numRepeated;
+        m_numSuppressed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Rate limit the messages of each severity.
+    CRateLimit& rateLimit{m_rateLimits.at(severityToRank(message.m_severity))};
+    if(now - rateLimit.m_lastRefill >= std::chrono::seconds{1})
+    {
+        rateLimit.m_numTokens  = rateLimit.m_messagesPerSecond;
+        rateLimit.m_lastRefill = now;
+    }
+    if(0 == rateLimit.m_numTokens)
+    {
+        m_numSuppressed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    --rateLimit.m_numTokens;
+
+    spdlog::level::level_enum level{ };
+    // clang-format off
+    switch(message.m_severity)
+    {
+    case GL_DEBUG_SEVERITY_HIGH:            level = spdlog::level::err; break;
+    case GL_DEBUG_SEVERITY_MEDIUM:          level = spdlog::level::warn; break;
+    case GL_DEBUG_SEVERITY_LOW:             level = spdlog::level::info; break;
+    default:                                level = spdlog::level::debug; break;
+    }
+    // clang-format on
+
+    if(0 != repetition.m_numRepeated)
+    {
+        m_logger->log(
+            level, "The previous message with the id {} was repeated {} times.", message.m_id,
+            repetition.m_numRepeated);
+    }
+    m_logger->log(
+        level, R"(Source: {}, Type: {}, Id: {}, Severity: {}, Message: "{}".)",
+        CError::debugSourceToString(message.m_source), CError::debugTypeToString(message.m_type), message.m_id,
+        CError::debugSeverityToString(message.m_severity), message.m_message.data( ));
+
+    repetition.m_lastLogged  = now;
+    repetition.m_numRepeated = 0;
+}
@@ -0,0 +1,140 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "glad/glad.h"
+#include "spdlog/logger.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+struct CDebugMessage
+{
+    static constexpr std::size_t k_maxLength{256};
+
+    GLenum                            m_source{ };
+    GLenum                            m_type{ };
+    GLuint                            m_id{ };
+    GLenum                            m_severity{ };
+    std::uint32_t                     m_length{ };
+    std::array<char, k_maxLength + 1> m_message{ };
+};
+
+/// Bounded multi-producer, single-consumer queue for the messages of the OpenGL debug output.
+///
+/// The debug message callback may be invoked on any driver thread, therefore push() only copies the message into a
+/// preallocated slot and never allocates, formats or throws. A background thread drains the slots into an
+/// asynchronous spdlog logger, drops repeated messages and rate limits the messages of each severity. Messages with the
+/// escalation severity are kept and thrown by escalate() at a safe point of the frame.
+class CDebugMessageQueue
+{
+public:
+    static constexpr std::size_t k_capacity{1024};
+
+public:
+    CDebugMessageQueue( );
+    ~CDebugMessageQueue( );
+
+    CDebugMessageQueue(CDebugMessageQueue const & other)            = delete;
+    CDebugMessageQueue& operator=(CDebugMessageQueue const & other) = delete;
+
+    CDebugMessageQueue(CDebugMessageQueue&& other)                  = delete;
+    CDebugMessageQueue& operator=(CDebugMessageQueue&& other)       = delete;
+
+public:
+    auto start( ) -> void;
+    auto stop( ) -> void;
+
+    auto push(
+        GLenum const         source,
+        GLenum const         type,
+        GLuint const         id,
+        GLenum const         severity,
+        GLsizei const        length,
+        GLchar const * const message) noexcept -> bool;
+
+    auto escalate( ) -> void;
+
+    auto setEscalationSeverity(GLenum const severity) -> void;
+    auto setRateLimit(GLenum const severity, std::uint32_t const messagesPerSecond) -> void;
+
+    auto getNumDropped( ) const -> std::uint64_t;
+    auto getNumSuppressed( ) const -> std::uint64_t;
+
+private:
+    struct CSlot
+    {
+        std::atomic<std::size_t> m_sequence{ };
+        CDebugMessage            m_message{ };
+    };
+
+    struct CRepetition
+    {
+        std::chrono::steady_clock::time_point m_lastLogged{ };
+        std::uint64_t                         m_numRepeated{ };
+    };
+
+    struct CRateLimit
+    {
+        std::uint32_t                         m_messagesPerSecond{ };
+        std::uint32_t                         m_numTokens{ };
+        std::chrono::steady_clock::time_point m_lastRefill{ };
+    };
+
+    static auto severityToRank(GLenum const severity) -> std::size_t;
+
+    auto        pop(CDebugMessage& message) -> bool;
+    auto        drain( ) -> void;
+    auto        process(CDebugMessage const & message) -> void;
+
+private:
+    std::unique_ptr<CSlot[]>                       m_slots{ };
+    std::atomic<std::size_t>                       m_enqueuePosition{ };
+    std::size_t                                    m_dequeuePosition{ };
+
+    std::atomic<std::uint64_t>                     m_numDropped{ };
+    std::atomic<std::uint64_t>                     m_numSuppressed{ };
+    std::uint64_t                                  m_numDroppedReported{ };
+
+    std::atomic<std::size_t>                       m_escalationRank{ };
+    std::atomic<bool>                              m_escalationClaimed{ };
+    std::atomic<bool>                              m_escalationPending{ };
+    CDebugMessage                                  m_escalationMessage{ };
+
+    std::unordered_map<std::uint64_t, CRepetition> m_repetitions{ };
+    std::array<CRateLimit, 4>                      m_rateLimits{ };
+
+    std::shared_ptr<spdlog::logger>                m_logger{ };
+    std::atomic<bool>                              m_running{ };
+    std::thread                                    m_thread{ };
+};
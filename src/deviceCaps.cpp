@@ -0,0 +1,368 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "deviceCaps.hpp"
+#include "stateVariables.hpp"
+#include "hash.hpp"
+
+#include "fmt/core.h"
+#include "spdlog/spdlog.h"
+
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace
+{
+struct CIntegerLimit
+{
+    GLenum m_name{ };
+    GLint  m_majorVersion{ };
+    GLint  m_minorVersion{ };
+};
+
+constexpr std::array k_integerLimits{
+    // clang-format off
+    CIntegerLimit{GL_MAJOR_VERSION,                     3, 0},
+    CIntegerLimit{GL_MINOR_VERSION,                     3, 0},
+    CIntegerLimit{GL_MAX_VERTEX_ATTRIBS,                2, 0},
+    CIntegerLimit{GL_MAX_ELEMENTS_VERTICES,             2, 0},
+    CIntegerLimit{GL_MAX_ELEMENTS_INDICES,              2, 0},
+    CIntegerLimit{GL_MAX_DRAW_BUFFERS,                  2, 0},
+    CIntegerLimit{GL_MAX_TEXTURE_BUFFER_SIZE,           3, 1},
+    CIntegerLimit{GL_MAX_TEXTURE_IMAGE_UNITS,           2, 0},
+    CIntegerLimit{GL_MAX_TEXTURE_SIZE,                  2, 0},
+    CIntegerLimit{GL_MAX_UNIFORM_LOCATIONS,             4, 3},
+    CIntegerLimit{GL_MAX_ELEMENT_INDEX,                 4, 3},
+    CIntegerLimit{GL_NUM_EXTENSIONS,                    3, 0},
+    CIntegerLimit{GL_MAX_VERTEX_UNIFORM_COMPONENTS,     2, 0},
+    CIntegerLimit{GL_MAX_VERTEX_UNIFORM_VECTORS,        4, 1},
+    CIntegerLimit{GL_MAX_VERTEX_UNIFORM_BLOCKS,         3, 1},
+    CIntegerLimit{GL_MAX_FRAGMENT_UNIFORM_COMPONENTS,   2, 0},
+    CIntegerLimit{GL_MAX_FRAGMENT_UNIFORM_VECTORS,      4, 1},
+    CIntegerLimit{GL_MAX_FRAGMENT_UNIFORM_BLOCKS,       3, 1},
+    CIntegerLimit{GL_MAX_UNIFORM_BUFFER_BINDINGS,       3, 1},
+    CIntegerLimit{GL_MAX_UNIFORM_BLOCK_SIZE,            3, 1},
+    CIntegerLimit{GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT,   3, 1},
+    CIntegerLimit{GL_NUM_PROGRAM_BINARY_FORMATS,        4, 1},
+    // clang-format on
+};
+
+constexpr std::array<char const *, static_cast<std::size_t>(EExtension::Count)> k_extensionNames{
+    "GL_ARB_buffer_storage",
+    "GL_ARB_direct_state_access",
+    "GL_ARB_get_program_binary",
+    "GL_ARB_multi_draw_indirect",
+    "GL_ARB_parallel_shader_compile",
+    "GL_ARB_program_interface_query",
+    "GL_ARB_separate_shader_objects",
+    "GL_ARB_shader_draw_parameters",
+    "GL_ARB_vertex_attrib_binding",
+    "GL_KHR_debug",
+    "GL_KHR_parallel_shader_compile",
+};
+
+constexpr char const * k_cacheFileHeader{"learn-opengl device capabilities 3"};
+}
+
+auto CDeviceCaps::create(std::filesystem::path const & cacheDirectory) -> void
+{
+    *this = { };
+
+    m_vendor   = CStateVariables::getString(GL_VENDOR);
+    m_renderer = CStateVariables::getString(GL_RENDERER);
+    m_version  = CStateVariables::getString(GL_VERSION);
+
+    std::filesystem::path cacheFilePath{ };
+    if(!cacheDirectory.empty( ))
+    {
+        std::uint64_t const key{fnv1a(m_version, fnv1a(m_renderer, fnv1a(m_vendor)))};
+        cacheFilePath = cacheDirectory / fmt::format("deviceCaps-{:016x}.txt", key);
+
+        m_isFromCache = load(cacheFilePath);
+    }
+
+    if(!m_isFromCache)
+    {
+        query( );
+        if(!cacheFilePath.empty( ))
+        {
+            save(cacheFilePath);
+        }
+    }
+
+    updateExtensions( );
+}
+
+auto CDeviceCaps::getVendor( ) const -> std::string const &
+{
+    return m_vendor;
+}
+
+auto CDeviceCaps::getRenderer( ) const -> std::string const &
+{
+    return m_renderer;
+}
+
+auto CDeviceCaps::getVersion( ) const -> std::string const &
+{
+    return m_version;
+}
+
+auto CDeviceCaps::getShadingLanguageVersion( ) const -> std::string const &
+{
+    return m_shadingLanguageVersion;
+}
+
+auto CDeviceCaps::getMajorVersion( ) const -> GLint
+{
+    return static_cast<GLint>(getInteger(GL_MAJOR_VERSION));
+}
+
+auto CDeviceCaps::getMinorVersion( ) const -> GLint
+{
+    return static_cast<GLint>(getInteger(GL_MINOR_VERSION));
+}
+
+auto CDeviceCaps::isVersion(GLint const majorVersion, GLint const minorVersion) const -> bool
+{
+    GLint const deviceMajorVersion{getMajorVersion( )};
+    return (deviceMajorVersion > majorVersion) ||
+           ((deviceMajorVersion == majorVersion) && (getMinorVersion( ) >= minorVersion));
+}
+
+auto CDeviceCaps::getInteger(GLenum const name) const -> GLint64
+{
+    auto const iter{m_integers.find(name)};
+    if(iter == m_integers.end( ))
+    {
+        throw std::out_of_range(fmt::format(
+            R"(The state variable "{}" is not part of the device capabilities.)",
+            CStateVariables::parameterToString(name)));
+    }
+    return iter->second;
+}
+
+auto CDeviceCaps::getPointSizeRange( ) const -> std::tuple<GLint, GLint>
+{
+    return m_pointSizeRange;
+}
+
+auto CDeviceCaps::hasExtension(EExtension const extension) const -> bool
+{
+    return m_knownExtensions.test(static_cast<std::size_t>(extension));
+}
+
+auto CDeviceCaps::hasExtension(std::string const & extension) const -> bool
+{
+    return m_extensions.end( ) != m_extensions.find(extension);
+}
+
+auto CDeviceCaps::isFromCache( ) const -> bool
+{
+    return m_isFromCache;
+}
+
+auto CDeviceCaps::print( ) const -> void
+{
+    fmt::println("{}: {}", CStateVariables::parameterToString(GL_VENDOR), m_vendor);
+    fmt::println("{}: {}", CStateVariables::parameterToString(GL_RENDERER), m_renderer);
+    fmt::println("{}: {}", CStateVariables::parameterToString(GL_VERSION), m_version);
+    fmt::println("{}: {}", CStateVariables::parameterToString(GL_SHADING_LANGUAGE_VERSION), m_shadingLanguageVersion);
+
+    for(CIntegerLimit const & limit : k_integerLimits)
+    {
+        auto const iter{m_integers.find(limit.m_name)};
+        if(iter != m_integers.end( ))
+        {
+            fmt::println("{}: {}", CStateVariables::parameterToString(limit.m_name), iter->second);
+        }
+    }
+
+    fmt::println(
+        "{}: [{}, {}]", CStateVariables::parameterToString(GL_POINT_SIZE_RANGE), std::get<0>(m_pointSizeRange),
+        std::get<1>(m_pointSizeRange));
+}
+
+auto CDeviceCaps::query( ) -> void
+{
+    m_shadingLanguageVersion = CStateVariables::getString(GL_SHADING_LANGUAGE_VERSION);
+
+    // The version gates the remaining limits and is therefore queried first.
+    m_integers[GL_MAJOR_VERSION] = CStateVariables::getInteger64(GL_MAJOR_VERSION);
+    m_integers[GL_MINOR_VERSION] = CStateVariables::getInteger64(GL_MINOR_VERSION);
+
+    for(CIntegerLimit const & limit : k_integerLimits)
+    {
+        if(isVersion(limit.m_majorVersion, limit.m_minorVersion))
+        {
+            m_integers[limit.m_name] = CStateVariables::getInteger64(limit.m_name);
+        }
+    }
+
+    m_pointSizeRange = CStateVariables::getPointSizeRange( );
+
+    for(std::string& extension : CStateVariables::getExtensions( ))
+    {
+        m_extensions.insert(std::move(extension));
+    }
+}
+
+auto CDeviceCaps::load(std::filesystem::path const & cacheFilePath) -> bool
+{
+    std::ifstream cacheFile{cacheFilePath};
+    std::string   line{ };
+    if(!std::getline(cacheFile, line) || (line != k_cacheFileHeader))
+    {
+        return false;
+    }
+
+    try
+    {
+        while(std::getline(cacheFile, line))
+        {
+            std::size_t const separator{line.find(' ')};
+            std::string const key{line.substr(0, separator)};
+            std::string const value{(std::string::npos == separator) ? std::string{ } : line.substr(separator + 1)};
+
+            if("vendor" == key)
+            {
+                if(value != m_vendor)
+                {
+                    return false;
+                }
+            }
+            else if("renderer" == key)
+            {
+                if(value != m_renderer)
+                {
+                    return false;
+                }
+            }
+            else if("version" == key)
+            {
+                if(value != m_version)
+                {
+                    return false;
+                }
+            }
+            else if("glsl" == key)
+            {
+                m_shadingLanguageVersion = value;
+            }
+            else if("integer" == key)
+            {
+                std::istringstream stream{value};
+                GLenum             name{ };
+                GLint64            integer{ };
+                if(!(stream >> name >> integer))
+                {
+                    return false;
+                }
+                m_integers[name] = integer;
+            }
+            else if("pointSizeRange" == key)
+            {
+                std::istringstream stream{value};
+                if(!(stream >> std::get<0>(m_pointSizeRange) >> std::get<1>(m_pointSizeRange)))
+                {
+                    return false;
+                }
+            }
+            else if("extension" == key)
+            {
+                m_extensions.insert(value);
+            }
+        }
+    }
+    catch(std::exception const & e)
+    {
+        spdlog::warn(R"(The device capabilities cache "{}" can not be read: {})", cacheFilePath.string( ), e.what( ));
+        return false;
+    }
+
+    bool const isComplete{
+        (m_integers.end( ) != m_integers.find(GL_MAJOR_VERSION)) &&
+        (m_integers.end( ) != m_integers.find(GL_MINOR_VERSION))};
+    if(!isComplete)
+    {
+        m_shadingLanguageVersion.clear( );
+        m_integers.clear( );
+        m_extensions.clear( );
+    }
+    return isComplete;
+}
+
+auto CDeviceCaps::save(std::filesystem::path const & cacheFilePath) const -> void
+{
+    // The snapshot is written to a temporary file first and renamed, readers never see a partial file.
+    std::filesystem::path const temporaryFilePath{cacheFilePath.string( ) + ".tmp"};
+    std::error_code             errorCode{ };
+
+    std::filesystem::create_directories(cacheFilePath.parent_path( ), errorCode);
+    {
+        std::ofstream cacheFile{temporaryFilePath, std::ios::trunc};
+        cacheFile << k_cacheFileHeader << '\n';
+        cacheFile << "vendor " << m_vendor << '\n';
+        cacheFile << "renderer " << m_renderer << '\n';
+        cacheFile << "version " << m_version << '\n';
+        cacheFile << "glsl " << m_shadingLanguageVersion << '\n';
+        cacheFile << "pointSizeRange " << std::get<0>(m_pointSizeRange) << ' ' << std::get<1>(m_pointSizeRange) << '\n';
+        for(auto const & [name, integer] : m_integers)
+        {
+            cacheFile << "integer " << name << ' ' << integer << '\n';
+        }
+        for(std::string const & extension : m_extensions)
+        {
+            cacheFile << "extension " << extension << '\n';
+        }
+        if(!cacheFile.flush( ))
+        {
+            spdlog::warn(R"(The device capabilities cache "{}" can not be written.)", cacheFilePath.string( ));
+            return;
+        }
+    }
+
+    std::filesystem::rename(temporaryFilePath, cacheFilePath, errorCode);
+    if(errorCode)
+    {
+        spdlog::warn(
+            R"(The device capabilities cache "{}" can not be written: {})", cacheFilePath.string( ),
+            errorCode.message( ));
+        std::filesystem::remove(temporaryFilePath, errorCode);
+    }
+}
+
+auto CDeviceCaps::updateExtensions( ) -> void
+{
+    for(std::size_t i{ }; i < k_numKnownExtensions; ++i)
+    {
+        m_knownExtensions.set(i, hasExtension(std::string{k_extensionNames.at(i)}));
+    }
+}
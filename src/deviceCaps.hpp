@@ -0,0 +1,101 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "glad/glad.h"
+
+#include <bitset>
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+enum class EExtension : std::size_t
+{
+    ArbBufferStorage,
+    ArbDirectStateAccess,
+    ArbGetProgramBinary,
+    ArbMultiDrawIndirect,
+    ArbParallelShaderCompile,
+    ArbProgramInterfaceQuery,
+    ArbSeparateShaderObjects,
+    ArbShaderDrawParameters,
+    ArbVertexAttribBinding,
+    KhrDebug,
+    KhrParallelShaderCompile,
+    Count
+};
+
+/// Snapshot of the capabilities of the device, taken once after the context is created.
+///
+/// The queries never touch the driver. The snapshot is written to the cache directory, keyed by the vendor, renderer
+/// and version strings, and later startups on the same driver read the file instead of querying every limit.
+class CDeviceCaps
+{
+public:
+    auto create(std::filesystem::path const & cacheDirectory = { }) -> void;
+
+    auto getVendor( ) const -> std::string const &;
+    auto getRenderer( ) const -> std::string const &;
+    auto getVersion( ) const -> std::string const &;
+    auto getShadingLanguageVersion( ) const -> std::string const &;
+
+    auto getMajorVersion( ) const -> GLint;
+    auto getMinorVersion( ) const -> GLint;
+    auto isVersion(GLint const majorVersion, GLint const minorVersion) const -> bool;
+
+    auto getInteger(GLenum const name) const -> GLint64;
+    auto getPointSizeRange( ) const -> std::tuple<GLint, GLint>;
+
+    auto hasExtension(EExtension const extension) const -> bool;
+    auto hasExtension(std::string const & extension) const -> bool;
+
+    auto isFromCache( ) const -> bool;
+
+    auto print( ) const -> void;
+
+private:
+    static constexpr std::size_t k_numKnownExtensions{static_cast<std::size_t>(EExtension::Count)};
+
+    auto                         query( ) -> void;
+    auto                         load(std::filesystem::path const & cacheFilePath) -> bool;
+    auto                         save(std::filesystem::path const & cacheFilePath) const -> void;
+    auto                         updateExtensions( ) -> void;
+
+private:
+    std::string                         m_vendor{ };
+    std::string                         m_renderer{ };
+    std::string                         m_version{ };
+    std::string                         m_shadingLanguageVersion{ };
+    std::unordered_map<GLenum, GLint64> m_integers{ };
+    std::tuple<GLint, GLint>            m_pointSizeRange{ };
+    std::unordered_set<std::string>     m_extensions{ };
+    std::bitset<k_numKnownExtensions>   m_knownExtensions{ };
+    bool                                m_isFromCache{ };
+};
@@ -0,0 +1,247 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "drawBatcher.hpp"
+#include "deviceCaps.hpp"
+#include "error.hpp"
+#include "hash.hpp"
+#include "indexNarrowing.hpp"
+#include "program.hpp"
+#include "stateCache.hpp"
+
+#include "fmt/core.h"
+#include "spdlog/spdlog.h"
+
+#include <cstring>
+#include <stdexcept>
+
+auto CDrawBatcher::create(CDeviceCaps const & deviceCaps, GLsizeiptr const frameSize, std::size_t const numFrames)
+    -> void
+{
+    destroy( );
+
+    // The shaders only see the base instance with the extension, drawIndex.glsl follows the define of getDefines( )
+    bool const hasDrawParameters{deviceCaps.hasExtension(EExtension::ArbShaderDrawParameters)};
+    m_isIndirect = hasDrawParameters &&
+                   (deviceCaps.isVersion(4, 3) || deviceCaps.hasExtension(EExtension::ArbMultiDrawIndirect)) &&
+                   (nullptr != glad_glMultiDrawElementsIndirect);
+    m_isBaseInstance = m_isIndirect || (hasDrawParameters && deviceCaps.isVersion(4, 2) &&
+                                        (nullptr != glad_glDrawElementsInstancedBaseVertexBaseInstance));
+    if(m_isIndirect)
+    {
+        m_commands.create(deviceCaps, GL_DRAW_INDIRECT_BUFFER, frameSize, numFrames);
+    }
+
+    spdlog::info(
+        "Draw batcher issues {} draws.",
+        m_isIndirect ? "multi indirect" : (m_isBaseInstance ? "separate base instance" : "separate"));
+}
+
+auto CDrawBatcher::destroy( ) -> void
+{
+    m_commands.destroy( );
+    m_isIndirect     = { };
+    m_isBaseInstance = { };
+    m_batches.clear( );
+    m_numBatches = { };
+    m_batchIndices.clear( );
+    m_numDraws   = { };
+    m_statistics = { };
+}
+
+auto CDrawBatcher::add(
+    CProgram&                    program,
+    GLuint const                 vertexArray,
+    GLenum const                 mode,
+    GLenum const                 indexType,
+    CDrawElementsCommand const & command) -> void
+{
+    std::uint64_t const programHash{fnv1a(program.getId( ), k_fnv1aOffsetBasis)};
+    std::uint64_t const hash{fnv1a(indexType, fnv1a(mode, fnv1a(vertexArray, programHash)))};
+    auto const [iterator, isInserted]{m_batchIndices.try_emplace(hash, m_numBatches)};
+    if(isInserted)
+    {
+        // Reuse the command storage of the batches of earlier frames
+        if(m_numBatches == m_batches.size( ))
+        {
+            m_batches.emplace_back( );
+        }
+
+        CBatch& batch{m_batches[m_numBatches++]};
+        batch.m_program     = &program;
+        batch.m_vertexArray = vertexArray;
+        batch.m_mode        = mode;
+        batch.m_indexType   = indexType;
+        batch.m_commands.clear( );
+    }
+
+    CBatch& batch{m_batches[iterator->second]};
+    if((batch.m_program->getId( ) != program.getId( )) || (batch.m_vertexArray != vertexArray) ||
+       (batch.m_mode != mode) || (batch.m_indexType != indexType))
+    {
+        throw std::runtime_error(fmt::format("Two draw batches share the hash {:016x}.", hash));
+    }
+
+    batch.m_commands.push_back(command);
+    ++m_numDraws;
+}
+
+auto CDrawBatcher::flush( ) -> void
+{
+    m_statistics              = { };
+    m_statistics.m_numDraws   = m_numDraws;
+    m_statistics.m_numBatches = m_numBatches;
+
+    if(0 < m_numDraws)
+    {
+        if(m_isIndirect)
+        {
+            flushIndirect( );
+        }
+        else
+        {
+            flushDirect( );
+        }
+    }
+
+    m_numBatches = { };
+    m_batchIndices.clear( );
+    m_numDraws = { };
+}
+
+auto CDrawBatcher::endFrame( ) -> void
+{
+    if(m_isIndirect)
+    {
+        m_commands.endFrame( );
+    }
+}
+
+auto CDrawBatcher::isIndirect( ) const -> bool
+{
+    return m_isIndirect;
+}
+
+auto CDrawBatcher::getDefines( ) const -> std::string_view
+{
+    return m_isBaseInstance ? "#define LEARNOGL_DRAW_INDEX_BASE_INSTANCE\n" : "";
+}
+
+auto CDrawBatcher::getNumDraws( ) const -> std::size_t
+{
+    return m_numDraws;
+}
+
+auto CDrawBatcher::getStatistics( ) const -> CStatistics
+{
+    return m_statistics;
+}
+
+auto CDrawBatcher::print( ) const -> void
+{
+    spdlog::info(
+        "Draw batcher: {} draws in {} batches, {} draw calls.", m_statistics.m_numDraws, m_statistics.m_numBatches,
+        m_statistics.m_numDrawCalls);
+}
+
+auto CDrawBatcher::flushIndirect( ) -> void
+{
+    // The commands of all batches go into one allocation, every batch draws its own range of it
+    GLsizeiptr const           size{static_cast<GLsizeiptr>(m_numDraws * sizeof(CDrawElementsCommand))};
+    CStreamingAllocation const allocation{m_commands.allocate(size, sizeof(GLuint))};
+
+    std::byte* data{static_cast<std::byte*>(allocation.m_data)};
+    for(std::size_t i{ }; i < m_numBatches; ++i)
+    {
+        std::vector<CDrawElementsCommand> const & commands{m_batches[i].m_commands};
+        std::memcpy(data, commands.data( ), commands.size( ) * sizeof(CDrawElementsCommand));
+        data += commands.size( ) * sizeof(CDrawElementsCommand);
+    }
+    m_commands.finish(allocation);
+
+    CStateCache& stateCache{CStateCache::get( )};
+    stateCache.bindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commands.getId( ));
+
+    GLintptr offset{allocation.m_offset};
+    for(std::size_t i{ }; i < m_numBatches; ++i)
+    {
+        CBatch const & batch{m_batches[i]};
+        stateCache.useProgram(batch.m_program->getId( ));
+        stateCache.bindVertexArray(batch.m_vertexArray);
+
+        GLsizei const      numCommands{static_cast<GLsizei>(batch.m_commands.size( ))};
+        void const * const commands{reinterpret_cast<void const *>(offset)};
+        GLCheck(glMultiDrawElementsIndirect(batch.m_mode, batch.m_indexType, commands, numCommands, 0));
+
+        offset += static_cast<GLintptr>(batch.m_commands.size( ) * sizeof(CDrawElementsCommand));
+        ++m_statistics.m_numDrawCalls;
+    }
+}
+
+auto CDrawBatcher::flushDirect( ) -> void
+{
+    CStateCache& stateCache{CStateCache::get( )};
+    for(std::size_t i{ }; i < m_numBatches; ++i)
+    {
+        CBatch const & batch{m_batches[i]};
+        stateCache.useProgram(batch.m_program->getId( ));
+        stateCache.bindVertexArray(batch.m_vertexArray);
+
+        // Programs without per-draw data do not declare the uniform, nor do the ones that read the base instance
+        CUniform const * const baseInstance{
+            m_isBaseInstance ? nullptr : batch.m_program->findUniform(k_baseInstance)};
+        GLsizeiptr const       indexSize{getIndexSize(batch.m_indexType)};
+        for(CDrawElementsCommand const & command : batch.m_commands)
+        {
+            if(nullptr != baseInstance)
+            {
+                batch.m_program->setUniform(baseInstance->m_location, static_cast<GLint>(command.m_baseInstance));
+            }
+
+            GLsizei const      count{static_cast<GLsizei>(command.m_count)};
+            void const * const indices{reinterpret_cast<void const *>(command.m_firstIndex * indexSize)};
+            if(m_isBaseInstance)
+            {
+                GLCheck(glDrawElementsInstancedBaseVertexBaseInstance(
+                    batch.m_mode, count, batch.m_indexType, indices, static_cast<GLsizei>(command.m_instanceCount),
+                    command.m_baseVertex, command.m_baseInstance));
+            }
+            else if(1 == command.m_instanceCount)
+            {
+                GLCheck(glDrawElementsBaseVertex(
+                    batch.m_mode, count, batch.m_indexType, indices, command.m_baseVertex));
+            }
+            else
+            {
+                GLsizei const instanceCount{static_cast<GLsizei>(command.m_instanceCount)};
+                GLCheck(glDrawElementsInstancedBaseVertex(
+                    batch.m_mode, count, batch.m_indexType, indices, instanceCount, command.m_baseVertex));
+            }
+            ++m_statistics.m_numDrawCalls;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "streamingBuffer.hpp"
+#include "uniform.hpp"
+
+#include "glad/glad.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class CDeviceCaps;
+class CProgram;
+
+/// Draw of indexed primitives, laid out as the DrawElementsIndirectCommand read by glMultiDrawElementsIndirect.
+struct CDrawElementsCommand
+{
+    GLuint m_count{ };
+    GLuint m_instanceCount{1};
+    /// Index of the first index in the element array buffer, not a byte offset.
+    GLuint m_firstIndex{ };
+    GLint  m_baseVertex{ };
+    /// Index of the per-draw data, see CDrawBatcher.
+    GLuint m_baseInstance{ };
+};
+
+static_assert(sizeof(CDrawElementsCommand) == (5 * sizeof(GLuint)), "The indirect command has to be tightly packed.");
+
+/// Groups indexed draws by program, vertex array, mode and index type and submits every group with a single
+/// glMultiDrawElementsIndirect call, its commands written to a streaming GL_DRAW_INDIRECT_BUFFER.
+///
+/// Shaders find the per-draw data at the base instance of the command. They read it as gl_BaseInstanceARB, so the
+/// indirect path needs GL_ARB_shader_draw_parameters as well. Without both extensions every draw is issued by its own
+/// call, with the base instance on OpenGL 4.2 and GL_ARB_shader_draw_parameters. Otherwise the base instance is written
+/// to the k_baseInstance uniform, which drawIndex.glsl declares in place of the built-in variable. The programs of the
+/// draws are created with getDefines( ), which tells drawIndex.glsl the variant the batcher chose.
+class CDrawBatcher
+{
+public:
+    static constexpr CUniformName k_baseInstance{"u_baseInstance"};
+    /// Holds the commands of 104857 draws per frame, more draws need a larger frame size.
+    static constexpr GLsizeiptr   k_defaultFrameSize{2 * 1024 * 1024};
+
+    struct CStatistics
+    {
+        std::size_t m_numDraws{ };
+        std::size_t m_numBatches{ };
+        std::size_t m_numDrawCalls{ };
+    };
+
+public:
+    CDrawBatcher( ) = default;
+    ~CDrawBatcher( ) = default;
+
+    CDrawBatcher(CDrawBatcher const & other)            = delete;
+    CDrawBatcher& operator=(CDrawBatcher const & other) = delete;
+
+    CDrawBatcher(CDrawBatcher&& other)                  = default;
+    CDrawBatcher& operator=(CDrawBatcher&& other)       = default;
+
+public:
+    /// The frame size bounds the commands of a frame, in bytes.
+    auto create(
+        CDeviceCaps const & deviceCaps,
+        GLsizeiptr const    frameSize = k_defaultFrameSize,
+        std::size_t const   numFrames = CStreamingBuffer::k_defaultNumRegions) -> void;
+    auto destroy( ) -> void;
+
+    auto add(
+        CProgram&                    program,
+        GLuint const                 vertexArray,
+        GLenum const                 mode,
+        GLenum const                 indexType,
+        CDrawElementsCommand const & command) -> void;
+    /// Issues the draws added since the last flush, batch by batch in the order of their first draw.
+    auto flush( ) -> void;
+    auto endFrame( ) -> void;
+
+    auto isIndirect( ) const -> bool;
+    /// Defines of the programs drawn by the batcher, LEARNOGL_DRAW_INDEX_BASE_INSTANCE is set if the draws pass the
+    /// index as their base instance.
+    auto getDefines( ) const -> std::string_view;
+    auto getNumDraws( ) const -> std::size_t;
+    /// Statistics of the last flush.
+    auto getStatistics( ) const -> CStatistics;
+    auto print( ) const -> void;
+
+private:
+    struct CBatch
+    {
+        CProgram*                         m_program{ };
+        GLuint                            m_vertexArray{ };
+        GLenum                            m_mode{ };
+        GLenum                            m_indexType{ };
+        std::vector<CDrawElementsCommand> m_commands{ };
+    };
+
+    auto flushIndirect( ) -> void;
+    auto flushDirect( ) -> void;
+
+private:
+    CStreamingBuffer                               m_commands{ };
+    bool                                           m_isIndirect{ };
+    bool                                           m_isBaseInstance{ };
+    /// Batches with draws since the last flush come first, the ones after them keep their storage for later frames.
+    std::vector<CBatch>                            m_batches{ };
+    std::size_t                                    m_numBatches{ };
+    std::unordered_map<std::uint64_t, std::size_t> m_batchIndices{ };
+    std::size_t                                    m_numDraws{ };
+    CStatistics                                    m_statistics{ };
+};
@@ -26,12 +26,17 @@
 /// ----------------------------------------------------------------------------
 
 #include "error.hpp"
+#include "debugMessageQueue.hpp"
 
 #include "fmt/core.h"
+#include "spdlog/spdlog.h"
 
 #include <string>
 #include <iostream>
 #include <cassert>
+#include <array>
+#include <algorithm>
+#include <utility>
 
 auto CError::clear( ) -> void
 {
@@ -48,7 +53,59 @@ auto CError::report(char const * function, char const * file, int const line) ->
         return;
     }
 
-    std::string       strError{ };
+    std::string const errorMessage{fmt::format(
+        R"(OpenGL error "{}" reported during the call of "{}" in "{}:{}".\n)", errorToString(error), function, file,
+        line)};
+    throw std::runtime_error(errorMessage);
+}
+
+auto CError::sweep(char const * scope, char const * file, int const line) -> std::size_t
+{
+    // glGetError keeps returning errors without a current context, therefore the number of iterations is limited.
+    constexpr std::size_t                         k_maxErrors{32};
+    std::array<std::pair<GLenum, std::size_t>, 8> errors{ };
+    std::size_t                                   numDistinctErrors{ };
+    std::size_t                                   numErrors{ };
+
+    for(GLenum error{glGetError( )}; (GL_NO_ERROR != error) && (numErrors < k_maxErrors); error = glGetError( ))
+    {
+        ++numErrors;
+
+        auto const end{errors.begin( ) + numDistinctErrors};
+        auto const iter{std::find_if(errors.begin( ), end, [error](auto const & entry) {
+            return entry.first == error;
+        })};
+        if(iter != end)
+        {
+            ++iter->second;
+        }
+        else if(numDistinctErrors < errors.size( ))
+        {
+            errors.at(numDistinctErrors++) = {error, 1};
+        }
+    }
+
+    if(0 == numErrors)
+    {
+        return numErrors;
+    }
+
+    std::string summary{ };
+    for(std::size_t i{ }; i < numDistinctErrors; ++i)
+    {
+        summary += fmt::format(
+            "{}{} x{}", (0 == i) ? "" : ", ", errorToString(errors.at(i).first), errors.at(i).second);
+    }
+    spdlog::error(
+        R"(OpenGL reported {} error(s) in the scope "{}" ending in "{}:{}": {}.)", numErrors, scope, file, line,
+        summary);
+
+    return numErrors;
+}
+
+auto CError::errorToString(GLenum const error) -> std::string
+{
+    std::string strError{ };
 
     // clang-format off
     switch(error)
@@ -65,32 +122,12 @@ auto CError::report(char const * function, char const * file, int const line) ->
     }
     // clang-format on
 
-    std::string const errorMessage{fmt::format(
-        R"(OpenGL error "{}" reported during the call of "{}" in "{}:{}".\n)", strError, function, file, line)};
-    throw std::runtime_error(errorMessage);
+    return strError;
 }
 
-auto CError::enableDebugOutput(void const * userParam) -> void
+auto CError::debugSourceToString(GLenum const source) -> char const *
 {
-#ifndef __APPLE__
-    GLCheck(glEnable(GL_DEBUG_OUTPUT));
-    GLCheck(glDebugMessageCallback(&CError::debugMessageCallback, userParam));
-#endif
-}
-
-auto CError::debugMessageCallback(
-    GLenum                        source,
-    GLenum                        type,
-    GLuint                        id,
-    GLenum                        severity,
-    [[maybe_unused]] GLsizei      length,
-    GLchar const *                message,
-    [[maybe_unused]] void const * userParam) -> void
-{
-    std::string       strSource{ };
-    std::string       strType{ };
-    std::string       strSeverity{ };
-
+    char const * strSource{"UNKNOWN"};
     // clang-format off
     switch(source)
     {
@@ -101,7 +138,14 @@ auto CError::debugMessageCallback(
     case GL_DEBUG_SOURCE_APPLICATION:       strSource = "GL_DEBUG_SOURCE_APPLICATION"; break;
     case GL_DEBUG_SOURCE_OTHER:             strSource = "GL_DEBUG_SOURCE_OTHER"; break;
     }
+    // clang-format on
+    return strSource;
+}
 
+auto CError::debugTypeToString(GLenum const type) -> char const *
+{
+    char const * strType{"UNKNOWN"};
+    // clang-format off
     switch(type)
     {
     case GL_DEBUG_TYPE_ERROR:               strType = "GL_DEBUG_TYPE_ERROR"; break;
@@ -114,7 +158,14 @@ auto CError::debugMessageCallback(
     case GL_DEBUG_TYPE_PUSH_GROUP:          strType = "GL_DEBUG_TYPE_PUSH_GROUP"; break;
     case GL_DEBUG_TYPE_POP_GROUP:           strType = "GL_DEBUG_TYPE_POP_GROUP"; break;
     }
+    // clang-format on
+    return strType;
+}
 
+auto CError::debugSeverityToString(GLenum const severity) -> char const *
+{
+    char const * strSeverity{"UNKNOWN"};
+    // clang-format off
     switch(severity)
     {
     case GL_DEBUG_SEVERITY_HIGH:            strSeverity = "GL_DEBUG_SEVERITY_HIGH"; break;
@@ -123,13 +174,56 @@ auto CError::debugMessageCallback(
     case GL_DEBUG_SEVERITY_NOTIFICATION:    strSeverity = "GL_DEBUG_SEVERITY_NOTIFICATION"; break;
     }
     // clang-format on
+    return strSeverity;
+}
 
-    std::string const errorMessage{fmt::format(
-        R"(Source: {}, Type: {}, Id: {}, Severity: {}, Message: "{}".)", strSource, strType, id, strSeverity, message)};
+auto CError::enableDebugOutput([[maybe_unused]] CDebugMessageQueue& messageQueue) -> void
+{
+#ifndef __APPLE__
+    GLCheck(glEnable(GL_DEBUG_OUTPUT));
+    GLCheck(glDebugMessageCallback(&CError::debugMessageCallback, &messageQueue));
+#endif
+}
 
-#ifdef _WIN64
-    __debugbreak( );
+auto CError::disableDebugOutput( ) -> void
+{
+#ifndef __APPLE__
+    // Without loaded entry points there is no context and no callback to unregister. Not checked, because the queue
+    // calls it from its destructor, which must not throw
+    if(nullptr != glad_glDebugMessageCallback)
+    {
+        glDebugMessageCallback(nullptr, nullptr);
+    }
 #endif
+}
 
-    throw std::runtime_error(errorMessage);
-}
\ No newline at end of file
+auto CError::debugMessageCallback(
+    GLenum         source,
+    GLenum         type,
+    GLuint         id,
+    GLenum         severity,
+    GLsizei        length,
+    GLchar const * message,
+    void const *   userParam) -> void
+{
+    // Called by the driver, possibly on another thread: the message is only queued, formatting and logging happen on
+    // the thread of the queue and errors are escalated by CDebugMessageQueue::escalate( ).
+    auto* const messageQueue{static_cast<CDebugMessageQueue*>(const_cast<void*>(userParam))};
+    if(nullptr == messageQueue)
+    {
+        return;
+    }
+    messageQueue->push(source, type, id, severity, length, message);
+}
+
+CErrorScope::CErrorScope(char const * name, char const * file, int const line)
+    : m_name{name}
+    , m_file{file}
+    , m_line{line}
+{
+}
+
+CErrorScope::~CErrorScope( )
+{
+    CError::sweep(m_name, m_file, m_line);
+}
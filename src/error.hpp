@@ -29,10 +29,42 @@
 
 #include "glad/glad.h"
 
+#include <string>
+
+class CDebugMessageQueue;
+
+//
+// OpenGL error checking modes of the GLCheck macro, selected at build time through LEARNOGL_GL_CHECK.
+//
+// - Off:         GLCheck compiles to the plain call and the context is created with GLFW_CONTEXT_NO_ERROR.
+// - Deferred:    GLCheck compiles to the plain call, errors are collected once per GLCheckScope and logged.
+// - Synchronous: Every call is surrounded by glGetError and the first error is thrown.
+//
+#define LEARNOGL_GL_CHECK_OFF         0
+#define LEARNOGL_GL_CHECK_DEFERRED    1
+#define LEARNOGL_GL_CHECK_SYNCHRONOUS 2
+
+#ifndef LEARNOGL_GL_CHECK
+#define LEARNOGL_GL_CHECK LEARNOGL_GL_CHECK_SYNCHRONOUS
+#endif
+
+#define LEARNOGL_GL_CHECK_CONCAT_IMPL(a, b) a##b
+#define LEARNOGL_GL_CHECK_CONCAT(a, b)      LEARNOGL_GL_CHECK_CONCAT_IMPL(a, b)
+
+#if LEARNOGL_GL_CHECK == LEARNOGL_GL_CHECK_SYNCHRONOUS
 #define GLCheck(x)                                                                                                     \
 CError::clear( );                                                                                                      \
 x;                                                                                                                     \
 CError::report(#x, __FILE__, __LINE__);
+#define GLCheckScope(name)
+#elif LEARNOGL_GL_CHECK == LEARNOGL_GL_CHECK_DEFERRED
+#define GLCheck(x) x;
+#define GLCheckScope(name)                                                                                             \
+CErrorScope const LEARNOGL_GL_CHECK_CONCAT(glCheckScope, __LINE__){name, __FILE__, __LINE__};
+#else
+#define GLCheck(x) x;
+#define GLCheckScope(name)
+#endif
 
 class CError
 {
@@ -44,7 +76,16 @@ public:
 
     static auto            report(char const * function, char const * file, int const line) -> void;
 
-    static auto            enableDebugOutput(void const * userParam = nullptr) -> void;
+    static auto            sweep(char const * scope, char const * file, int const line) -> std::size_t;
+
+    static auto            errorToString(GLenum const error) -> std::string;
+    static auto            debugSourceToString(GLenum const source) -> char const *;
+    static auto            debugTypeToString(GLenum const type) -> char const *;
+    static auto            debugSeverityToString(GLenum const severity) -> char const *;
+
+    static auto            enableDebugOutput(CDebugMessageQueue& messageQueue) -> void;
+    /// Unregisters the callback, the context must still be current.
+    static auto            disableDebugOutput( ) -> void;
 
     static auto GLAPIENTRY debugMessageCallback(
         GLenum         source,
@@ -55,3 +96,21 @@ public:
         GLchar const * message,
         void const *   userParam) -> void;
 };
+
+class CErrorScope
+{
+public:
+    CErrorScope(char const * name, char const * file, int const line);
+    ~CErrorScope( );
+
+    CErrorScope(CErrorScope const & other)            = delete;
+    CErrorScope& operator=(CErrorScope const & other) = delete;
+
+    CErrorScope(CErrorScope&& other)                  = delete;
+    CErrorScope& operator=(CErrorScope&& other)       = delete;
+
+private:
+    char const * m_name{ };
+    char const * m_file{ };
+    int          m_line{ };
+};
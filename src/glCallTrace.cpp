@@ -0,0 +1,253 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "glCallTrace.hpp"
+#include "glFunctionList.hpp"
+
+#include "glad/glad.h"
+#include "fmt/core.h"
+#include "fmt/os.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+enum class EGLFunction : std::size_t
+{
+#define LEARNOGL_GL_FUNCTION_ENUMERATOR(name) name##Index,
+    LEARNOGL_GL_FUNCTION_LIST(LEARNOGL_GL_FUNCTION_ENUMERATOR)
+#undef LEARNOGL_GL_FUNCTION_ENUMERATOR
+    Count
+};
+
+constexpr std::size_t k_numFunctions{static_cast<std::size_t>(EGLFunction::Count)};
+
+constexpr std::array<char const *, k_numFunctions> k_functionNames{
+#define LEARNOGL_GL_FUNCTION_NAME(name) #name,
+    LEARNOGL_GL_FUNCTION_LIST(LEARNOGL_GL_FUNCTION_NAME)
+#undef LEARNOGL_GL_FUNCTION_NAME
+};
+
+// Upper limit of the recorded calls for the chrome trace, the counters are updated for every call.
+constexpr std::size_t k_maxEvents{std::size_t{1} << 20};
+
+using CClock = std::chrono::steady_clock;
+
+struct CCallCounter
+{
+    std::uint64_t    m_numCalls{ };
+    CClock::duration m_duration{ };
+};
+
+struct CCallEvent
+{
+    std::uint32_t      m_function{ };
+    std::uint32_t      m_frame{ };
+    CClock::time_point m_start{ };
+    CClock::duration   m_duration{ };
+};
+
+struct CTraceState
+{
+    std::array<CCallCounter, k_numFunctions> m_counters{ };
+    std::array<CCallCounter, k_numFunctions> m_lastFrameCounters{ };
+    std::vector<CCallEvent>                  m_events{ };
+    std::vector<CClock::time_point>          m_frameStarts{ };
+    std::uint64_t                            m_numDroppedEvents{ };
+    std::uint32_t                            m_frame{ };
+};
+
+CTraceState       s_trace{ };
+thread_local bool t_isTracedThread{ };
+
+auto record(std::size_t const function, CClock::time_point const start) -> void
+{
+    CClock::duration const duration{CClock::now( ) - start};
+
+    CCallCounter& counter{s_trace.m_counters[function]};
+    ++counter.m_numCalls;
+    counter.m_duration += duration;
+
+    if(s_trace.m_events.size( ) < k_maxEvents)
+    {
+        s_trace.m_events.push_back({static_cast<std::uint32_t>(function), s_trace.m_frame, start, duration});
+    }
+    else
+    {
+        ++s_trace.m_numDroppedEvents;
+    }
+}
+
+template <std::size_t Index, auto* Slot, typename Proc = std::remove_pointer_t<decltype(Slot)>>
+struct CHook;
+
+template <std::size_t Index, auto* Slot, typename Result, typename... Args>
+struct CHook<Index, Slot, Result(APIENTRYP)(Args...)>
+{
+    static inline Result(APIENTRYP s_original)(Args...){ };
+
+    static auto APIENTRY call(Args... args) -> Result
+    {
+        if(!t_isTracedThread)
+        {
+            return s_original(args...);
+        }
+
+        CClock::time_point const start{CClock::now( )};
+        if constexpr(std::is_void_v<Result>)
+        {
+            s_original(args...);
+            record(Index, start);
+        }
+        else
+        {
+            Result const result{s_original(args...)};
+            record(Index, start);
+            return result;
+        }
+    }
+
+    static auto install( ) -> void
+    {
+        if((nullptr != *Slot) && (&call != *Slot))
+        {
+            s_original = *Slot;
+            *Slot      = &call;
+        }
+    }
+
+    static auto uninstall( ) -> void
+    {
+        if(&call == *Slot)
+        {
+            *Slot = s_original;
+        }
+    }
+};
+
+auto toMicroseconds(CClock::duration const duration) -> double
+{
+    return std::chrono::duration<double, std::micro>{duration}.count( );
+}
+}
+
+auto CGLCallTrace::install( ) -> void
+{
+#define LEARNOGL_GL_FUNCTION_INSTALL(name)                                                                             \
+    CHook<static_cast<std::size_t>(EGLFunction::name##Index), &glad_##name>::install( );
+    LEARNOGL_GL_FUNCTION_LIST(LEARNOGL_GL_FUNCTION_INSTALL)
+#undef LEARNOGL_GL_FUNCTION_INSTALL
+
+    s_trace = { };
+    s_trace.m_events.reserve(k_maxEvents / 16);
+    s_trace.m_frameStarts.push_back(CClock::now( ));
+    t_isTracedThread = true;
+}
+
+auto CGLCallTrace::uninstall( ) -> void
+{
+#define LEARNOGL_GL_FUNCTION_UNINSTALL(name)                                                                           \
+    CHook<static_cast<std::size_t>(EGLFunction::name##Index), &glad_##name>::uninstall( );
+    LEARNOGL_GL_FUNCTION_LIST(LEARNOGL_GL_FUNCTION_UNINSTALL)
+#undef LEARNOGL_GL_FUNCTION_UNINSTALL
+
+    t_isTracedThread = false;
+}
+
+auto CGLCallTrace::endFrame( ) -> void
+{
+    s_trace.m_lastFrameCounters = std::exchange(s_trace.m_counters, { });
+    s_trace.m_frameStarts.push_back(CClock::now( ));
+    ++s_trace.m_frame;
+}
+
+auto CGLCallTrace::printFrameSummary( ) -> void
+{
+    std::vector<std::size_t> functions(k_numFunctions);
+    std::iota(functions.begin( ), functions.end( ), std::size_t{ });
+    functions.erase(
+        std::remove_if(
+            functions.begin( ), functions.end( ),
+            [](std::size_t const function) {
+                return 0 == s_trace.m_lastFrameCounters[function].m_numCalls;
+            }),
+        functions.end( ));
+    std::sort(functions.begin( ), functions.end( ), [](std::size_t const lhs, std::size_t const rhs) {
+        return s_trace.m_lastFrameCounters[lhs].m_duration > s_trace.m_lastFrameCounters[rhs].m_duration;
+    });
+
+    CCallCounter total{ };
+    fmt::println("OpenGL calls of frame {}:", (0 == s_trace.m_frame) ? 0 : s_trace.m_frame - 1);
+    fmt::println("{:<40} {:>10} {:>14} {:>12}", "Function", "Calls", "Total [us]", "Mean [ns]");
+    for(std::size_t const function : functions)
+    {
+        CCallCounter const & counter{s_trace.m_lastFrameCounters[function]};
+        fmt::println(
+            "{:<40} {:>10} {:>14.3f} {:>12.1f}", k_functionNames[function], counter.m_numCalls,
+            toMicroseconds(counter.m_duration),
+            std::chrono::duration<double, std::nano>{counter.m_duration}.count( ) / counter.m_numCalls);
+        total.m_numCalls += counter.m_numCalls;
+        total.m_duration += counter.m_duration;
+    }
+    fmt::println("{:<40} {:>10} {:>14.3f}", "Total", total.m_numCalls, toMicroseconds(total.m_duration));
+}
+
+auto CGLCallTrace::writeChromeTrace(std::filesystem::path const & traceFilePath) -> void
+{
+    CClock::time_point const traceStart{s_trace.m_frameStarts.front( )};
+    fmt::ostream             traceFile{fmt::output_file(traceFilePath.string( ))};
+
+    traceFile.print(R"({{"displayTimeUnit":"ns","traceEvents":[)");
+
+    char const * separator{""};
+    for(std::size_t frame{1}; frame < s_trace.m_frameStarts.size( ); ++frame)
+    {
+        traceFile.print(
+            R"({}{{"name":"frame {}","cat":"frame","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":0,"tid":0}})", separator,
+            frame - 1, toMicroseconds(s_trace.m_frameStarts[frame - 1] - traceStart),
+            toMicroseconds(s_trace.m_frameStarts[frame] - s_trace.m_frameStarts[frame - 1]));
+        separator = ",\n";
+    }
+
+    for(CCallEvent const & event : s_trace.m_events)
+    {
+        traceFile.print(
+            R"({}{{"name":"{}","cat":"gl","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":0,"tid":0,"args":{{"frame":{}}}}})",
+            separator, k_functionNames[event.m_function], toMicroseconds(event.m_start - traceStart),
+            toMicroseconds(event.m_duration), event.m_frame);
+        separator = ",\n";
+    }
+
+    traceFile.print(R"(],"otherData":{{"droppedEvents":{}}}}})", s_trace.m_numDroppedEvents);
+}
@@ -0,0 +1,56 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <filesystem>
+
+/// Optional instrumentation of the OpenGL function pointers loaded by glad, enabled with LEARNOGL_GL_TRACE.
+///
+/// install( ) replaces every loaded glad_gl* pointer with a trampoline that counts and times the call with a steady
+/// clock before it forwards to the driver. Only the calls of the thread which installed the trampolines are recorded.
+class CGLCallTrace
+{
+public:
+    CGLCallTrace( )                                     = delete;
+    ~CGLCallTrace( )                                    = delete;
+
+    CGLCallTrace(CGLCallTrace const & other)            = delete;
+    CGLCallTrace& operator=(CGLCallTrace const & other) = delete;
+
+    CGLCallTrace(CGLCallTrace&& other)                  = delete;
+    CGLCallTrace& operator=(CGLCallTrace&& other)       = delete;
+
+public:
+    static auto install( ) -> void;
+    static auto uninstall( ) -> void;
+
+    static auto endFrame( ) -> void;
+
+    static auto printFrameSummary( ) -> void;
+    static auto writeChromeTrace(std::filesystem::path const & traceFilePath) -> void;
+};
@@ -0,0 +1,733 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+//
+// X-macro list of every OpenGL entry point loaded by external/glad (gl=4.6, core profile), generated with:
+// grep -oE '^GLAPI PFN\w+PROC glad_gl\w+;' external/glad/include/glad/glad.h | sed -E 's/.*glad_(gl\w+);/    F(\1) \\/'
+//
+#define LEARNOGL_GL_FUNCTION_LIST(F) \
+    F(glCullFace) \
+    F(glFrontFace) \
+    F(glHint) \
+    F(glLineWidth) \
+    F(glPointSize) \
+    F(glPolygonMode) \
+    F(glScissor) \
+    F(glTexParameterf) \
+    F(glTexParameterfv) \
+    F(glTexParameteri) \
+    F(glTexParameteriv) \
+    F(glTexImage1D) \
+    F(glTexImage2D) \
+    F(glDrawBuffer) \
+    F(glClear) \
+    F(glClearColor) \
+    F(glClearStencil) \
+    F(glClearDepth) \
+    F(glStencilMask) \
+    F(glColorMask) \
+    F(glDepthMask) \
+    F(glDisable) \
+    F(glEnable) \
+    F(glFinish) \
+    F(glFlush) \
+    F(glBlendFunc) \
+    F(glLogicOp) \
+    F(glStencilFunc) \
+    F(glStencilOp) \
+    F(glDepthFunc) \
+    F(glPixelStoref) \
+    F(glPixelStorei) \
+    F(glReadBuffer) \
+    F(glReadPixels) \
+    F(glGetBooleanv) \
+    F(glGetDoublev) \
+    F(glGetError) \
+    F(glGetFloatv) \
+    F(glGetIntegerv) \
+    F(glGetString) \
+    F(glGetTexImage) \
+    F(glGetTexParameterfv) \
+    F(glGetTexParameteriv) \
+    F(glGetTexLevelParameterfv) \
+    F(glGetTexLevelParameteriv) \
+    F(glIsEnabled) \
+    F(glDepthRange) \
+    F(glViewport) \
+    F(glDrawArrays) \
+    F(glDrawElements) \
+    F(glPolygonOffset) \
+    F(glCopyTexImage1D) \
+    F(glCopyTexImage2D) \
+    F(glCopyTexSubImage1D) \
+    F(glCopyTexSubImage2D) \
+    F(glTexSubImage1D) \
+    F(glTexSubImage2D) \
+    F(glBindTexture) \
+    F(glDeleteTextures) \
+    F(glGenTextures) \
+    F(glIsTexture) \
+    F(glDrawRangeElements) \
+    F(glTexImage3D) \
+    F(glTexSubImage3D) \
+    F(glCopyTexSubImage3D) \
+    F(glActiveTexture) \
+    F(glSampleCoverage) \
+    F(glCompressedTexImage3D) \
+    F(glCompressedTexImage2D) \
+    F(glCompressedTexImage1D) \
+    F(glCompressedTexSubImage3D) \
+    F(glCompressedTexSubImage2D) \
+    F(glCompressedTexSubImage1D) \
+    F(glGetCompressedTexImage) \
+    F(glBlendFuncSeparate) \
+    F(glMultiDrawArrays) \
+    F(glMultiDrawElements) \
+    F(glPointParameterf) \
+    F(glPointParameterfv) \
+    F(glPointParameteri) \
+    F(glPointParameteriv) \
+    F(glBlendColor) \
+    F(glBlendEquation) \
+    F(glGenQueries) \
+    F(glDeleteQueries) \
+    F(glIsQuery) \
+    F(glBeginQuery) \
+    F(glEndQuery) \
+    F(glGetQueryiv) \
+    F(glGetQueryObjectiv) \
+    F(glGetQueryObjectuiv) \
+    F(glBindBuffer) \
+    F(glDeleteBuffers) \
+    F(glGenBuffers) \
+    F(glIsBuffer) \
+    F(glBufferData) \
+    F(glBufferSubData) \
+    F(glGetBufferSubData) \
+    F(glMapBuffer) \
+    F(glUnmapBuffer) \
+    F(glGetBufferParameteriv) \
+    F(glGetBufferPointerv) \
+    F(glBlendEquationSeparate) \
+    F(glDrawBuffers) \
+    F(glStencilOpSeparate) \
+    F(glStencilFuncSeparate) \
+    F(glStencilMaskSeparate) \
+    F(glAttachShader) \
+    F(glBindAttribLocation) \
+    F(glCompileShader) \
+    F(glCreateProgram) \
+    F(glCreateShader) \
+    F(glDeleteProgram) \
+    F(glDeleteShader) \
+    F(glDetachShader) \
+    F(glDisableVertexAttribArray) \
+    F(glEnableVertexAttribArray) \
+    F(glGetActiveAttrib) \
+    F(glGetActiveUniform) \
+    F(glGetAttachedShaders) \
+    F(glGetAttribLocation) \
+    F(glGetProgramiv) \
+    F(glGetProgramInfoLog) \
+    F(glGetShaderiv) \
+    F(glGetShaderInfoLog) \
+    F(glGetShaderSource) \
+    F(glGetUniformLocation) \
+    F(glGetUniformfv) \
+    F(glGetUniformiv) \
+    F(glGetVertexAttribdv) \
+    F(glGetVertexAttribfv) \
+    F(glGetVertexAttribiv) \
+    F(glGetVertexAttribPointerv) \
+    F(glIsProgram) \
+    F(glIsShader) \
+    F(glLinkProgram) \
+    F(glShaderSource) \
+    F(glUseProgram) \
+    F(glUniform1f) \
+    F(glUniform2f) \
+    F(glUniform3f) \
+    F(glUniform4f) \
+    F(glUniform1i) \
+    F(glUniform2i) \
+    F(glUniform3i) \
+    F(glUniform4i) \
+    F(glUniform1fv) \
+    F(glUniform2fv) \
+    F(glUniform3fv) \
+    F(glUniform4fv) \
+    F(glUniform1iv) \
+    F(glUniform2iv) \
+    F(glUniform3iv) \
+    F(glUniform4iv) \
+    F(glUniformMatrix2fv) \
+    F(glUniformMatrix3fv) \
+    F(glUniformMatrix4fv) \
+    F(glValidateProgram) \
+    F(glVertexAttrib1d) \
+    F(glVertexAttrib1dv) \
+    F(glVertexAttrib1f) \
+    F(glVertexAttrib1fv) \
+    F(glVertexAttrib1s) \
+    F(glVertexAttrib1sv) \
+    F(glVertexAttrib2d) \
+    F(glVertexAttrib2dv) \
+    F(glVertexAttrib2f) \
+    F(glVertexAttrib2fv) \
+    F(glVertexAttrib2s) \
+    F(glVertexAttrib2sv) \
+    F(glVertexAttrib3d) \
+    F(glVertexAttrib3dv) \
+    F(glVertexAttrib3f) \
+    F(glVertexAttrib3fv) \
+    F(glVertexAttrib3s) \
+    F(glVertexAttrib3sv) \
+    F(glVertexAttrib4Nbv) \
+    F(glVertexAttrib4Niv) \
+    F(glVertexAttrib4Nsv) \
+    F(glVertexAttrib4Nub) \
+    F(glVertexAttrib4Nubv) \
+    F(glVertexAttrib4Nuiv) \
+    F(glVertexAttrib4Nusv) \
+    F(glVertexAttrib4bv) \
+    F(glVertexAttrib4d) \
+    F(glVertexAttrib4dv) \
+    F(glVertexAttrib4f) \
+    F(glVertexAttrib4fv) \
+    F(glVertexAttrib4iv) \
+    F(glVertexAttrib4s) \
+    F(glVertexAttrib4sv) \
+    F(glVertexAttrib4ubv) \
+    F(glVertexAttrib4uiv) \
+    F(glVertexAttrib4usv) \
+    F(glVertexAttribPointer) \
+    F(glUniformMatrix2x3fv) \
+    F(glUniformMatrix3x2fv) \
+    F(glUniformMatrix2x4fv) \
+    F(glUniformMatrix4x2fv) \
+    F(glUniformMatrix3x4fv) \
+    F(glUniformMatrix4x3fv) \
+    F(glColorMaski) \
+    F(glGetBooleani_v) \
+    F(glGetIntegeri_v) \
+    F(glEnablei) \
+    F(glDisablei) \
+    F(glIsEnabledi) \
+    F(glBeginTransformFeedback) \
+    F(glEndTransformFeedback) \
+    F(glBindBufferRange) \
+    F(glBindBufferBase) \
+    F(glTransformFeedbackVaryings) \
+    F(glGetTransformFeedbackVarying) \
+    F(glClampColor) \
+    F(glBeginConditionalRender) \
+    F(glEndConditionalRender) \
+    F(glVertexAttribIPointer) \
+    F(glGetVertexAttribIiv) \
+    F(glGetVertexAttribIuiv) \
+    F(glVertexAttribI1i) \
+    F(glVertexAttribI2i) \
+    F(glVertexAttribI3i) \
+    F(glVertexAttribI4i) \
+    F(glVertexAttribI1ui) \
+    F(glVertexAttribI2ui) \
+    F(glVertexAttribI3ui) \
+    F(glVertexAttribI4ui) \
+    F(glVertexAttribI1iv) \
+    F(glVertexAttribI2iv) \
+    F(glVertexAttribI3iv) \
+    F(glVertexAttribI4iv) \
+    F(glVertexAttribI1uiv) \
+    F(glVertexAttribI2uiv) \
+    F(glVertexAttribI3uiv) \
+    F(glVertexAttribI4uiv) \
+    F(glVertexAttribI4bv) \
+    F(glVertexAttribI4sv) \
+    F(glVertexAttribI4ubv) \
+    F(glVertexAttribI4usv) \
+    F(glGetUniformuiv) \
+    F(glBindFragDataLocation) \
+    F(glGetFragDataLocation) \
+    F(glUniform1ui) \
+    F(glUniform2ui) \
+    F(glUniform3ui) \
+    F(glUniform4ui) \
+    F(glUniform1uiv) \
+    F(glUniform2uiv) \
+    F(glUniform3uiv) \
+    F(glUniform4uiv) \
+    F(glTexParameterIiv) \
+    F(glTexParameterIuiv) \
+    F(glGetTexParameterIiv) \
+    F(glGetTexParameterIuiv) \
+    F(glClearBufferiv) \
+    F(glClearBufferuiv) \
+    F(glClearBufferfv) \
+    F(glClearBufferfi) \
+    F(glGetStringi) \
+    F(glIsRenderbuffer) \
+    F(glBindRenderbuffer) \
+    F(glDeleteRenderbuffers) \
+    F(glGenRenderbuffers) \
+    F(glRenderbufferStorage) \
+    F(glGetRenderbufferParameteriv) \
+    F(glIsFramebuffer) \
+    F(glBindFramebuffer) \
+    F(glDeleteFramebuffers) \
+    F(glGenFramebuffers) \
+    F(glCheckFramebufferStatus) \
+    F(glFramebufferTexture1D) \
+    F(glFramebufferTexture2D) \
+    F(glFramebufferTexture3D) \
+    F(glFramebufferRenderbuffer) \
+    F(glGetFramebufferAttachmentParameteriv) \
+    F(glGenerateMipmap) \
+    F(glBlitFramebuffer) \
+    F(glRenderbufferStorageMultisample) \
+    F(glFramebufferTextureLayer) \
+    F(glMapBufferRange) \
+    F(glFlushMappedBufferRange) \
+    F(glBindVertexArray) \
+    F(glDeleteVertexArrays) \
+    F(glGenVertexArrays) \
+    F(glIsVertexArray) \
+    F(glDrawArraysInstanced) \
+    F(glDrawElementsInstanced) \
+    F(glTexBuffer) \
+    F(glPrimitiveRestartIndex) \
+    F(glCopyBufferSubData) \
+    F(glGetUniformIndices) \
+    F(glGetActiveUniformsiv) \
+    F(glGetActiveUniformName) \
+    F(glGetUniformBlockIndex) \
+    F(glGetActiveUniformBlockiv) \
+    F(glGetActiveUniformBlockName) \
+    F(glUniformBlockBinding) \
+    F(glDrawElementsBaseVertex) \
+    F(glDrawRangeElementsBaseVertex) \
+    F(glDrawElementsInstancedBaseVertex) \
+    F(glMultiDrawElementsBaseVertex) \
+    F(glProvokingVertex) \
+    F(glFenceSync) \
+    F(glIsSync) \
+    F(glDeleteSync) \
+    F(glClientWaitSync) \
+    F(glWaitSync) \
+    F(glGetInteger64v) \
+    F(glGetSynciv) \
+    F(glGetInteger64i_v) \
+    F(glGetBufferParameteri64v) \
+    F(glFramebufferTexture) \
+    F(glTexImage2DMultisample) \
+    F(glTexImage3DMultisample) \
+    F(glGetMultisamplefv) \
+    F(glSampleMaski) \
+    F(glBindFragDataLocationIndexed) \
+    F(glGetFragDataIndex) \
+    F(glGenSamplers) \
+    F(glDeleteSamplers) \
+    F(glIsSampler) \
+    F(glBindSampler) \
+    F(glSamplerParameteri) \
+    F(glSamplerParameteriv) \
+    F(glSamplerParameterf) \
+    F(glSamplerParameterfv) \
+    F(glSamplerParameterIiv) \
+    F(glSamplerParameterIuiv) \
+    F(glGetSamplerParameteriv) \
+    F(glGetSamplerParameterIiv) \
+    F(glGetSamplerParameterfv) \
+    F(glGetSamplerParameterIuiv) \
+    F(glQueryCounter) \
+    F(glGetQueryObjecti64v) \
+    F(glGetQueryObjectui64v) \
+    F(glVertexAttribDivisor) \
+    F(glVertexAttribP1ui) \
+    F(glVertexAttribP1uiv) \
+    F(glVertexAttribP2ui) \
+    F(glVertexAttribP2uiv) \
+    F(glVertexAttribP3ui) \
+    F(glVertexAttribP3uiv) \
+    F(glVertexAttribP4ui) \
+    F(glVertexAttribP4uiv) \
+    F(glVertexP2ui) \
+    F(glVertexP2uiv) \
+    F(glVertexP3ui) \
+    F(glVertexP3uiv) \
+    F(glVertexP4ui) \
+    F(glVertexP4uiv) \
+    F(glTexCoordP1ui) \
+    F(glTexCoordP1uiv) \
+    F(glTexCoordP2ui) \
+    F(glTexCoordP2uiv) \
+    F(glTexCoordP3ui) \
+    F(glTexCoordP3uiv) \
+    F(glTexCoordP4ui) \
+    F(glTexCoordP4uiv) \
+    F(glMultiTexCoordP1ui) \
+    F(glMultiTexCoordP1uiv) \
+    F(glMultiTexCoordP2ui) \
+    F(glMultiTexCoordP2uiv) \
+    F(glMultiTexCoordP3ui) \
+    F(glMultiTexCoordP3uiv) \
+    F(glMultiTexCoordP4ui) \
+    F(glMultiTexCoordP4uiv) \
+    F(glNormalP3ui) \
+    F(glNormalP3uiv) \
+    F(glColorP3ui) \
+    F(glColorP3uiv) \
+    F(glColorP4ui) \
+    F(glColorP4uiv) \
+    F(glSecondaryColorP3ui) \
+    F(glSecondaryColorP3uiv) \
+    F(glMinSampleShading) \
+    F(glBlendEquationi) \
+    F(glBlendEquationSeparatei) \
+    F(glBlendFunci) \
+    F(glBlendFuncSeparatei) \
+    F(glDrawArraysIndirect) \
+    F(glDrawElementsIndirect) \
+    F(glUniform1d) \
+    F(glUniform2d) \
+    F(glUniform3d) \
+    F(glUniform4d) \
+    F(glUniform1dv) \
+    F(glUniform2dv) \
+    F(glUniform3dv) \
+    F(glUniform4dv) \
+    F(glUniformMatrix2dv) \
+    F(glUniformMatrix3dv) \
+    F(glUniformMatrix4dv) \
+    F(glUniformMatrix2x3dv) \
+    F(glUniformMatrix2x4dv) \
+    F(glUniformMatrix3x2dv) \
+    F(glUniformMatrix3x4dv) \
+    F(glUniformMatrix4x2dv) \
+    F(glUniformMatrix4x3dv) \
+    F(glGetUniformdv) \
+    F(glGetSubroutineUniformLocation) \
+    F(glGetSubroutineIndex) \
+    F(glGetActiveSubroutineUniformiv) \
+    F(glGetActiveSubroutineUniformName) \
+    F(glGetActiveSubroutineName) \
+    F(glUniformSubroutinesuiv) \
+    F(glGetUniformSubroutineuiv) \
+    F(glGetProgramStageiv) \
+    F(glPatchParameteri) \
+    F(glPatchParameterfv) \
+    F(glBindTransformFeedback) \
+    F(glDeleteTransformFeedbacks) \
+    F(glGenTransformFeedbacks) \
+    F(glIsTransformFeedback) \
+    F(glPauseTransformFeedback) \
+    F(glResumeTransformFeedback) \
+    F(glDrawTransformFeedback) \
+    F(glDrawTransformFeedbackStream) \
+    F(glBeginQueryIndexed) \
+    F(glEndQueryIndexed) \
+    F(glGetQueryIndexediv) \
+    F(glReleaseShaderCompiler) \
+    F(glShaderBinary) \
+    F(glGetShaderPrecisionFormat) \
+    F(glDepthRangef) \
+    F(glClearDepthf) \
+    F(glGetProgramBinary) \
+    F(glProgramBinary) \
+    F(glProgramParameteri) \
+    F(glUseProgramStages) \
+    F(glActiveShaderProgram) \
+    F(glCreateShaderProgramv) \
+    F(glBindProgramPipeline) \
+    F(glDeleteProgramPipelines) \
+    F(glGenProgramPipelines) \
+    F(glIsProgramPipeline) \
+    F(glGetProgramPipelineiv) \
+    F(glProgramUniform1i) \
+    F(glProgramUniform1iv) \
+    F(glProgramUniform1f) \
+    F(glProgramUniform1fv) \
+    F(glProgramUniform1d) \
+    F(glProgramUniform1dv) \
+    F(glProgramUniform1ui) \
+    F(glProgramUniform1uiv) \
+    F(glProgramUniform2i) \
+    F(glProgramUniform2iv) \
+    F(glProgramUniform2f) \
+    F(glProgramUniform2fv) \
+    F(glProgramUniform2d) \
+    F(glProgramUniform2dv) \
+    F(glProgramUniform2ui) \
+    F(glProgramUniform2uiv) \
+    F(glProgramUniform3i) \
+    F(glProgramUniform3iv) \
+    F(glProgramUniform3f) \
+    F(glProgramUniform3fv) \
+    F(glProgramUniform3d) \
+    F(glProgramUniform3dv) \
+    F(glProgramUniform3ui) \
+    F(glProgramUniform3uiv) \
+    F(glProgramUniform4i) \
+    F(glProgramUniform4iv) \
+    F(glProgramUniform4f) \
+    F(glProgramUniform4fv) \
+    F(glProgramUniform4d) \
+    F(glProgramUniform4dv) \
+    F(glProgramUniform4ui) \
+    F(glProgramUniform4uiv) \
+    F(glProgramUniformMatrix2fv) \
+    F(glProgramUniformMatrix3fv) \
+    F(glProgramUniformMatrix4fv) \
+    F(glProgramUniformMatrix2dv) \
+    F(glProgramUniformMatrix3dv) \
+    F(glProgramUniformMatrix4dv) \
+    F(glProgramUniformMatrix2x3fv) \
+    F(glProgramUniformMatrix3x2fv) \
+    F(glProgramUniformMatrix2x4fv) \
+    F(glProgramUniformMatrix4x2fv) \
+    F(glProgramUniformMatrix3x4fv) \
+    F(glProgramUniformMatrix4x3fv) \
+    F(glProgramUniformMatrix2x3dv) \
+    F(glProgramUniformMatrix3x2dv) \
+    F(glProgramUniformMatrix2x4dv) \
+    F(glProgramUniformMatrix4x2dv) \
+    F(glProgramUniformMatrix3x4dv) \
+    F(glProgramUniformMatrix4x3dv) \
+    F(glValidateProgramPipeline) \
+    F(glGetProgramPipelineInfoLog) \
+    F(glVertexAttribL1d) \
+    F(glVertexAttribL2d) \
+    F(glVertexAttribL3d) \
+    F(glVertexAttribL4d) \
+    F(glVertexAttribL1dv) \
+    F(glVertexAttribL2dv) \
+    F(glVertexAttribL3dv) \
+    F(glVertexAttribL4dv) \
+    F(glVertexAttribLPointer) \
+    F(glGetVertexAttribLdv) \
+    F(glViewportArrayv) \
+    F(glViewportIndexedf) \
+    F(glViewportIndexedfv) \
+    F(glScissorArrayv) \
+    F(glScissorIndexed) \
+    F(glScissorIndexedv) \
+    F(glDepthRangeArrayv) \
+    F(glDepthRangeIndexed) \
+    F(glGetFloati_v) \
+    F(glGetDoublei_v) \
+    F(glDrawArraysInstancedBaseInstance) \
+    F(glDrawElementsInstancedBaseInstance) \
+    F(glDrawElementsInstancedBaseVertexBaseInstance) \
+    F(glGetInternalformativ) \
+    F(glGetActiveAtomicCounterBufferiv) \
+    F(glBindImageTexture) \
+    F(glMemoryBarrier) \
+    F(glTexStorage1D) \
+    F(glTexStorage2D) \
+    F(glTexStorage3D) \
+    F(glDrawTransformFeedbackInstanced) \
+    F(glDrawTransformFeedbackStreamInstanced) \
+    F(glClearBufferData) \
+    F(glClearBufferSubData) \
+    F(glDispatchCompute) \
+    F(glDispatchComputeIndirect) \
+    F(glCopyImageSubData) \
+    F(glFramebufferParameteri) \
+    F(glGetFramebufferParameteriv) \
+    F(glGetInternalformati64v) \
+    F(glInvalidateTexSubImage) \
+    F(glInvalidateTexImage) \
+    F(glInvalidateBufferSubData) \
+    F(glInvalidateBufferData) \
+    F(glInvalidateFramebuffer) \
+    F(glInvalidateSubFramebuffer) \
+    F(glMultiDrawArraysIndirect) \
+    F(glMultiDrawElementsIndirect) \
+    F(glGetProgramInterfaceiv) \
+    F(glGetProgramResourceIndex) \
+    F(glGetProgramResourceName) \
+    F(glGetProgramResourceiv) \
+    F(glGetProgramResourceLocation) \
+    F(glGetProgramResourceLocationIndex) \
+    F(glShaderStorageBlockBinding) \
+    F(glTexBufferRange) \
+    F(glTexStorage2DMultisample) \
+    F(glTexStorage3DMultisample) \
+    F(glTextureView) \
+    F(glBindVertexBuffer) \
+    F(glVertexAttribFormat) \
+    F(glVertexAttribIFormat) \
+    F(glVertexAttribLFormat) \
+    F(glVertexAttribBinding) \
+    F(glVertexBindingDivisor) \
+    F(glDebugMessageControl) \
+    F(glDebugMessageInsert) \
+    F(glDebugMessageCallback) \
+    F(glGetDebugMessageLog) \
+    F(glPushDebugGroup) \
+    F(glPopDebugGroup) \
+    F(glObjectLabel) \
+    F(glGetObjectLabel) \
+    F(glObjectPtrLabel) \
+    F(glGetObjectPtrLabel) \
+    F(glGetPointerv) \
+    F(glBufferStorage) \
+    F(glClearTexImage) \
+    F(glClearTexSubImage) \
+    F(glBindBuffersBase) \
+    F(glBindBuffersRange) \
+    F(glBindTextures) \
+    F(glBindSamplers) \
+    F(glBindImageTextures) \
+    F(glBindVertexBuffers) \
+    F(glClipControl) \
+    F(glCreateTransformFeedbacks) \
+    F(glTransformFeedbackBufferBase) \
+    F(glTransformFeedbackBufferRange) \
+    F(glGetTransformFeedbackiv) \
+    F(glGetTransformFeedbacki_v) \
+    F(glGetTransformFeedbacki64_v) \
+    F(glCreateBuffers) \
+    F(glNamedBufferStorage) \
+    F(glNamedBufferData) \
+    F(glNamedBufferSubData) \
+    F(glCopyNamedBufferSubData) \
+    F(glClearNamedBufferData) \
+    F(glClearNamedBufferSubData) \
+    F(glMapNamedBuffer) \
+    F(glMapNamedBufferRange) \
+    F(glUnmapNamedBuffer) \
+    F(glFlushMappedNamedBufferRange) \
+    F(glGetNamedBufferParameteriv) \
+    F(glGetNamedBufferParameteri64v) \
+    F(glGetNamedBufferPointerv) \
+    F(glGetNamedBufferSubData) \
+    F(glCreateFramebuffers) \
+    F(glNamedFramebufferRenderbuffer) \
+    F(glNamedFramebufferParameteri) \
+    F(glNamedFramebufferTexture) \
+    F(glNamedFramebufferTextureLayer) \
+    F(glNamedFramebufferDrawBuffer) \
+    F(glNamedFramebufferDrawBuffers) \
+    F(glNamedFramebufferReadBuffer) \
+    F(glInvalidateNamedFramebufferData) \
+    F(glInvalidateNamedFramebufferSubData) \
+    F(glClearNamedFramebufferiv) \
+    F(glClearNamedFramebufferuiv) \
+    F(glClearNamedFramebufferfv) \
+    F(glClearNamedFramebufferfi) \
+    F(glBlitNamedFramebuffer) \
+    F(glCheckNamedFramebufferStatus) \
+    F(glGetNamedFramebufferParameteriv) \
+    F(glGetNamedFramebufferAttachmentParameteriv) \
+    F(glCreateRenderbuffers) \
+    F(glNamedRenderbufferStorage) \
+    F(glNamedRenderbufferStorageMultisample) \
+    F(glGetNamedRenderbufferParameteriv) \
+    F(glCreateTextures) \
+    F(glTextureBuffer) \
+    F(glTextureBufferRange) \
+    F(glTextureStorage1D) \
+    F(glTextureStorage2D) \
+    F(glTextureStorage3D) \
+    F(glTextureStorage2DMultisample) \
+    F(glTextureStorage3DMultisample) \
+    F(glTextureSubImage1D) \
+    F(glTextureSubImage2D) \
+    F(glTextureSubImage3D) \
+    F(glCompressedTextureSubImage1D) \
+    F(glCompressedTextureSubImage2D) \
+    F(glCompressedTextureSubImage3D) \
+    F(glCopyTextureSubImage1D) \
+    F(glCopyTextureSubImage2D) \
+    F(glCopyTextureSubImage3D) \
+    F(glTextureParameterf) \
+    F(glTextureParameterfv) \
+    F(glTextureParameteri) \
+    F(glTextureParameterIiv) \
+    F(glTextureParameterIuiv) \
+    F(glTextureParameteriv) \
+    F(glGenerateTextureMipmap) \
+    F(glBindTextureUnit) \
+    F(glGetTextureImage) \
+    F(glGetCompressedTextureImage) \
+    F(glGetTextureLevelParameterfv) \
+    F(glGetTextureLevelParameteriv) \
+    F(glGetTextureParameterfv) \
+    F(glGetTextureParameterIiv) \
+    F(glGetTextureParameterIuiv) \
+    F(glGetTextureParameteriv) \
+    F(glCreateVertexArrays) \
+    F(glDisableVertexArrayAttrib) \
+    F(glEnableVertexArrayAttrib) \
+    F(glVertexArrayElementBuffer) \
+    F(glVertexArrayVertexBuffer) \
+    F(glVertexArrayVertexBuffers) \
+    F(glVertexArrayAttribBinding) \
+    F(glVertexArrayAttribFormat) \
+    F(glVertexArrayAttribIFormat) \
+    F(glVertexArrayAttribLFormat) \
+    F(glVertexArrayBindingDivisor) \
+    F(glGetVertexArrayiv) \
+    F(glGetVertexArrayIndexediv) \
+    F(glGetVertexArrayIndexed64iv) \
+    F(glCreateSamplers) \
+    F(glCreateProgramPipelines) \
+    F(glCreateQueries) \
+    F(glGetQueryBufferObjecti64v) \
+    F(glGetQueryBufferObjectiv) \
+    F(glGetQueryBufferObjectui64v) \
+    F(glGetQueryBufferObjectuiv) \
+    F(glMemoryBarrierByRegion) \
+    F(glGetTextureSubImage) \
+    F(glGetCompressedTextureSubImage) \
+    F(glGetGraphicsResetStatus) \
+    F(glGetnCompressedTexImage) \
+    F(glGetnTexImage) \
+    F(glGetnUniformdv) \
+    F(glGetnUniformfv) \
+    F(glGetnUniformiv) \
+    F(glGetnUniformuiv) \
+    F(glReadnPixels) \
+    F(glGetnMapdv) \
+    F(glGetnMapfv) \
+    F(glGetnMapiv) \
+    F(glGetnPixelMapfv) \
+    F(glGetnPixelMapuiv) \
+    F(glGetnPixelMapusv) \
+    F(glGetnPolygonStipple) \
+    F(glGetnColorTable) \
+    F(glGetnConvolutionFilter) \
+    F(glGetnSeparableFilter) \
+    F(glGetnHistogram) \
+    F(glGetnMinmax) \
+    F(glTextureBarrier) \
+    F(glSpecializeShader) \
+    F(glMultiDrawArraysIndirectCount) \
+    F(glMultiDrawElementsIndirectCount) \
+    F(glPolygonOffsetClamp)
@@ -0,0 +1,64 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+constexpr std::uint64_t k_fnv1aOffsetBasis{0xCBF2'9CE4'8422'2325};
+constexpr std::uint64_t k_fnv1aPrime{0x0000'0100'0000'01B3};
+
+/// 64-bit FNV-1a hash, usable at compile time. The seed chains the hashes of several strings.
+constexpr auto fnv1a(std::string_view const value, std::uint64_t const seed = k_fnv1aOffsetBasis) -> std::uint64_t
+{
+    std::uint64_t hash{seed};
+    for(char const character : value)
+    {
+        hash ^= static_cast<std::uint8_t>(character);
+        hash *= k_fnv1aPrime;
+    }
+    return hash;
+}
+
+/// Continues the hash with the bytes of an integral or enumeration value, the least significant byte first.
+template<typename T>
+constexpr auto fnv1a(T const value, std::uint64_t const seed)
+    -> std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, std::uint64_t>
+{
+    std::uint64_t const bytes{static_cast<std::uint64_t>(value)};
+
+    std::uint64_t hash{seed};
+    for(std::size_t byte{ }; byte < sizeof(T); ++byte)
+    {
+        hash ^= (bytes >> (byte * 8)) & 0xFF;
+        hash *= k_fnv1aPrime;
+    }
+    return hash;
+}
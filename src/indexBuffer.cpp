@@ -27,7 +27,14 @@
 
 #include "indexBuffer.hpp"
 #include "error.hpp"
+#include "stateCache.hpp"
+#include "stateAccess.hpp"
+#include "indexNarrowing.hpp"
 
+#include "fmt/core.h"
+
+#include <limits>
+#include <stdexcept>
 #include <utility>
 
 CIndexBuffer::~CIndexBuffer( )
@@ -45,19 +52,33 @@ CIndexBuffer& CIndexBuffer::operator=(CIndexBuffer&& other)
     if(this != &other)
     {
         destroy( );
-        m_indexBufferId = std::exchange(other.m_indexBufferId, { });
+        m_indexBufferId      = std::exchange(other.m_indexBufferId, { });
+        m_type               = std::exchange(other.m_type, GLenum{GL_UNSIGNED_INT});
+        m_count              = std::exchange(other.m_count, { });
+        m_isPrimitiveRestart = std::exchange(other.m_isPrimitiveRestart, { });
     }
     return *this;
 }
 
-auto CIndexBuffer::create(GLuint const * const data, GLsizeiptr const count, EBufferUsagePattern const usage) -> void
+auto CIndexBuffer::create(
+    GLubyte const * const data, GLsizeiptr const count, EBufferUsagePattern const usage, bool const primitiveRestart)
+    -> void
 {
-    destroy( );
+    createNarrowest(data, count, usage, primitiveRestart);
+}
+
+auto CIndexBuffer::create(
+    GLushort const * const data, GLsizeiptr const count, EBufferUsagePattern const usage, bool const primitiveRestart)
+    -> void
+{
+    createNarrowest(data, count, usage, primitiveRestart);
+}
 
-    GLCheck(glGenBuffers(1, &m_indexBufferId));
-    bind();
-    GLCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * count, data, static_cast<GLenum>(usage)));
-    unbind();
+auto CIndexBuffer::create(
+    GLuint const * const data, GLsizeiptr const count, EBufferUsagePattern const usage, bool const primitiveRestart)
+    -> void
+{
+    createNarrowest(data, count, usage, primitiveRestart);
 }
 
 auto CIndexBuffer::destroy( ) -> void
@@ -67,20 +88,163 @@ auto CIndexBuffer::destroy( ) -> void
         return;
     }
     GLCheck(glDeleteBuffers(1, &m_indexBufferId));
+    CStateCache::get( ).forgetBuffer(m_indexBufferId);
     m_indexBufferId = { };
 }
 
+auto CIndexBuffer::adopt(
+    GLuint const indexBufferId, GLenum const type, GLsizei const count, bool const primitiveRestart) -> void
+{
+    bool const isIndexType{(GL_UNSIGNED_BYTE == type) || (GL_UNSIGNED_SHORT == type) || (GL_UNSIGNED_INT == type)};
+    if(!isIndexType)
+    {
+        throw std::runtime_error(fmt::format("The type 0x{:04X} is not an index type.", type));
+    }
+
+    destroy( );
+    m_indexBufferId      = indexBufferId;
+    m_type               = type;
+    m_count              = count;
+    m_isPrimitiveRestart = primitiveRestart;
+}
+
+auto CIndexBuffer::update(GLintptr const first, GLuint const * const data, GLsizeiptr const count) -> void
+{
+    GLvoid const *        source{data};
+    std::vector<GLubyte>  narrowedBytes{ };
+    std::vector<GLushort> narrowedShorts{ };
+    std::size_t const     numIndices{static_cast<std::size_t>(count)};
+
+    if(GL_UNSIGNED_INT != m_type)
+    {
+        GLuint const maxIndex{getMaxIndex(data, numIndices, m_isPrimitiveRestart)};
+        bool const   isInRange{
+            (GL_UNSIGNED_BYTE == m_type) ? isIndexInRange<GLubyte>(maxIndex, m_isPrimitiveRestart)
+                                         : isIndexInRange<GLushort>(maxIndex, m_isPrimitiveRestart)};
+        if(!isInRange)
+        {
+            throw std::runtime_error(
+                fmt::format("The index {} does not fit the {}-bit index buffer.", maxIndex, 8 * getIndexSize(m_type)));
+        }
+
+        if(GL_UNSIGNED_BYTE == m_type)
+        {
+            narrowedBytes = narrowIndices<GLubyte>(data, numIndices, m_isPrimitiveRestart);
+            source        = narrowedBytes.data( );
+        }
+        else
+        {
+            narrowedShorts = narrowIndices<GLushort>(data, numIndices, m_isPrimitiveRestart);
+            source         = narrowedShorts.data( );
+        }
+    }
+
+    GLsizeiptr const indexSize{getIndexSize(m_type)};
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glNamedBufferSubData(m_indexBufferId, indexSize * first, indexSize * count, source));
+    }
+    else
+    {
+        CStateCache::get( ).bindBuffer(GL_COPY_WRITE_BUFFER, m_indexBufferId);
+        GLCheck(glBufferSubData(GL_COPY_WRITE_BUFFER, indexSize * first, indexSize * count, source));
+    }
+}
+
 auto CIndexBuffer::getId( ) const -> GLuint
 {
     return m_indexBufferId;
 }
 
+auto CIndexBuffer::getType( ) const -> GLenum
+{
+    return m_type;
+}
+
+auto CIndexBuffer::getCount( ) const -> GLsizei
+{
+    return m_count;
+}
+
+auto CIndexBuffer::getRestartIndex( ) const -> GLuint
+{
+    return (GL_UNSIGNED_BYTE == m_type)    ? std::numeric_limits<GLubyte>::max( )
+           : (GL_UNSIGNED_SHORT == m_type) ? std::numeric_limits<GLushort>::max( )
+                                           : std::numeric_limits<GLuint>::max( );
+}
+
+auto CIndexBuffer::isPrimitiveRestart( ) const -> bool
+{
+    return m_isPrimitiveRestart;
+}
+
 auto CIndexBuffer::bind( ) const -> void
 {
-    GLCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferId));
+    CStateCache::get( ).bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferId);
 }
 
 auto CIndexBuffer::unbind( ) const -> void
 {
-    GLCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+    CStateCache::get( ).bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+template<typename TIndex>
+auto CIndexBuffer::createNarrowest(
+    TIndex const * const data, GLsizeiptr const count, EBufferUsagePattern const usage, bool const primitiveRestart)
+    -> void
+{
+    m_isPrimitiveRestart = primitiveRestart;
+    if(nullptr == data)
+    {
+        upload(getIndexType<TIndex>( ), nullptr, count, usage);
+        return;
+    }
+
+    std::size_t const numIndices{static_cast<std::size_t>(count)};
+    GLuint const      maxIndex{getMaxIndex(data, numIndices, primitiveRestart)};
+
+    if constexpr(sizeof(TIndex) > sizeof(GLubyte))
+    {
+        if(isIndexInRange<GLubyte>(maxIndex, primitiveRestart))
+        {
+            upload(GL_UNSIGNED_BYTE, narrowIndices<GLubyte>(data, numIndices, primitiveRestart).data( ), count, usage);
+            return;
+        }
+    }
+    if constexpr(sizeof(TIndex) > sizeof(GLushort))
+    {
+        if(isIndexInRange<GLushort>(maxIndex, primitiveRestart))
+        {
+            upload(
+                GL_UNSIGNED_SHORT, narrowIndices<GLushort>(data, numIndices, primitiveRestart).data( ), count, usage);
+            return;
+        }
+    }
+    upload(getIndexType<TIndex>( ), data, count, usage);
+}
+
+auto CIndexBuffer::upload(
+    GLenum const type, GLvoid const * const data, GLsizeiptr const count, EBufferUsagePattern const usage) -> void
+{
+    destroy( );
+
+    m_type  = type;
+    m_count = static_cast<GLsizei>(count);
+
+    GLsizeiptr const size{getIndexSize(type) * count};
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glCreateBuffers(1, &m_indexBufferId));
+        GLvoid const * const storageData{(0 < size) ? data : nullptr};
+        GLCheck(glNamedBufferStorage(
+            m_indexBufferId, getBufferStorageSize(size), storageData, getUpdatableStorageFlags( )));
+    }
+    else
+    {
+        // The element array buffer binding is part of the bound vertex array, the data is uploaded through the copy
+        // write target to leave the vertex array untouched.
+        GLCheck(glGenBuffers(1, &m_indexBufferId));
+        CStateCache::get( ).bindBuffer(GL_COPY_WRITE_BUFFER, m_indexBufferId);
+        GLCheck(glBufferData(GL_COPY_WRITE_BUFFER, size, data, static_cast<GLenum>(usage)));
+    }
 }
@@ -44,17 +44,55 @@ public:
     CIndexBuffer& operator=(CIndexBuffer&& other);
 
 public:
+    /// The indices are stored with the narrowest type that holds the largest index. With primitive restart, the
+    /// largest value of the source type marks a restart and the largest value of the stored type is kept free for it,
+    /// as expected by GL_PRIMITIVE_RESTART_FIXED_INDEX. The draws of such a buffer set CDrawPacket::k_primitiveRestart.
+    /// Without data the buffer keeps the type of the pointer.
+    auto create(
+        GLubyte const * const     data,
+        GLsizeiptr const          count,
+        EBufferUsagePattern const usage            = EBufferUsagePattern::StaticDraw,
+        bool const                primitiveRestart = false) -> void;
+    auto create(
+        GLushort const * const    data,
+        GLsizeiptr const          count,
+        EBufferUsagePattern const usage            = EBufferUsagePattern::StaticDraw,
+        bool const                primitiveRestart = false) -> void;
     auto create(
         GLuint const * const      data,
         GLsizeiptr const          count,
-        EBufferUsagePattern const usage = EBufferUsagePattern::StaticDraw) -> void;
+        EBufferUsagePattern const usage            = EBufferUsagePattern::StaticDraw,
+        bool const                primitiveRestart = false) -> void;
     auto destroy( ) -> void;
 
+    /// Takes ownership of a buffer created elsewhere, e.g. by CAsyncUploader, holding count indices of the type.
+    auto adopt(GLuint const indexBufferId, GLenum const type, GLsizei const count, bool const primitiveRestart = false)
+        -> void;
+
+    auto update(GLintptr const first, GLuint const * const data, GLsizeiptr const count) -> void;
+
     auto getId( ) const -> GLuint;
+    auto getType( ) const -> GLenum;
+    auto getCount( ) const -> GLsizei;
+    auto getRestartIndex( ) const -> GLuint;
+    auto isPrimitiveRestart( ) const -> bool;
 
     auto bind( ) const -> void;
     auto unbind( ) const -> void;
 
 private:
-    GLuint m_indexBufferId{ };
+    template<typename TIndex>
+    auto createNarrowest(
+        TIndex const * const      data,
+        GLsizeiptr const          count,
+        EBufferUsagePattern const usage,
+        bool const                primitiveRestart) -> void;
+    auto upload(GLenum const type, GLvoid const * const data, GLsizeiptr const count, EBufferUsagePattern const usage)
+        -> void;
+
+private:
+    GLuint  m_indexBufferId{ };
+    GLenum  m_type{GL_UNSIGNED_INT};
+    GLsizei m_count{ };
+    bool    m_isPrimitiveRestart{ };
 };
\ No newline at end of file
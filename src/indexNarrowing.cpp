@@ -0,0 +1,162 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "indexNarrowing.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace
+{
+template<typename TIndex>
+auto getMaxIndexScalar(TIndex const * const indices, std::size_t const count, bool const skipRestartIndex) -> GLuint
+{
+    constexpr TIndex k_restartIndex{std::numeric_limits<TIndex>::max( )};
+
+    TIndex maxIndex{ };
+    for(std::size_t i{ }; i < count; ++i)
+    {
+        if(!skipRestartIndex || (k_restartIndex != indices[i]))
+        {
+            maxIndex = std::max(maxIndex, indices[i]);
+        }
+    }
+    return maxIndex;
+}
+
+#ifdef LEARNOGL_SIMD_SSE2
+// Unsigned 32-bit maximum. SSE2 compares signed integers only, flipping the sign bits maps the unsigned order onto the
+// signed one.
+auto getMaxEpu32(__m128i const a, __m128i const b) -> __m128i
+{
+#ifdef LEARNOGL_SIMD_SSE41
+    return _mm_max_epu32(a, b);
+#else
+    __m128i const signBit{_mm_set1_epi32(std::numeric_limits<int>::min( ))};
+    __m128i const isGreater{_mm_cmpgt_epi32(_mm_xor_si128(a, signBit), _mm_xor_si128(b, signBit))};
+    return _mm_or_si128(_mm_and_si128(isGreater, a), _mm_andnot_si128(isGreater, b));
+#endif
+}
+
+template<typename TIndex>
+auto getHorizontalMax(__m128i const value) -> GLuint
+{
+    std::array<TIndex, 16 / sizeof(TIndex)> lanes{ };
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.data( )), value);
+    return *std::max_element(lanes.begin( ), lanes.end( ));
+}
+#endif
+}
+
+auto getMaxIndex(GLubyte const * const indices, std::size_t const count, bool const skipRestartIndex) -> GLuint
+{
+    std::size_t i{ };
+    GLuint      maxIndex{ };
+
+#ifdef LEARNOGL_SIMD_SSE2
+    if(count >= 16)
+    {
+        __m128i const restartIndex{_mm_set1_epi8(static_cast<char>(0xFF))};
+        __m128i       maxValue{_mm_setzero_si128( )};
+        for(; (i + 16) <= count; i += 16)
+        {
+            __m128i value{_mm_loadu_si128(reinterpret_cast<__m128i const *>(indices + i))};
+            if(skipRestartIndex)
+            {
+                value = _mm_andnot_si128(_mm_cmpeq_epi8(value, restartIndex), value);
+            }
+            maxValue = _mm_max_epu8(maxValue, value);
+        }
+        maxIndex = getHorizontalMax<GLubyte>(maxValue);
+    }
+#endif
+
+    return std::max(maxIndex, getMaxIndexScalar(indices + i, count - i, skipRestartIndex));
+}
+
+auto getMaxIndex(GLushort const * const indices, std::size_t const count, bool const skipRestartIndex) -> GLuint
+{
+    std::size_t i{ };
+    GLuint      maxIndex{ };
+
+#ifdef LEARNOGL_SIMD_SSE2
+    if(count >= 8)
+    {
+        __m128i const restartIndex{_mm_set1_epi16(static_cast<short>(0xFFFF))};
+        __m128i       maxValue{_mm_setzero_si128( )};
+        for(; (i + 8) <= count; i += 8)
+        {
+            __m128i value{_mm_loadu_si128(reinterpret_cast<__m128i const *>(indices + i))};
+            if(skipRestartIndex)
+            {
+                value = _mm_andnot_si128(_mm_cmpeq_epi16(value, restartIndex), value);
+            }
+#ifdef LEARNOGL_SIMD_SSE41
+            maxValue = _mm_max_epu16(maxValue, value);
+#else
+            // SSE2 lacks the unsigned 16-bit maximum, max(a, b) = (a -| b) + b with saturating subtraction
+            maxValue = _mm_add_epi16(_mm_subs_epu16(maxValue, value), value);
+#endif
+        }
+        maxIndex = getHorizontalMax<GLushort>(maxValue);
+    }
+#endif
+
+    return std::max(maxIndex, getMaxIndexScalar(indices + i, count - i, skipRestartIndex));
+}
+
+auto getMaxIndex(GLuint const * const indices, std::size_t const count, bool const skipRestartIndex) -> GLuint
+{
+    std::size_t i{ };
+    GLuint      maxIndex{ };
+
+#ifdef LEARNOGL_SIMD_SSE2
+    if(count >= 8)
+    {
+        __m128i const restartIndex{_mm_set1_epi32(-1)};
+        __m128i       maxValue0{_mm_setzero_si128( )};
+        __m128i       maxValue1{_mm_setzero_si128( )};
+        for(; (i + 8) <= count; i += 8)
+        {
+            __m128i value0{_mm_loadu_si128(reinterpret_cast<__m128i const *>(indices + i))};
+            __m128i value1{_mm_loadu_si128(reinterpret_cast<__m128i const *>(indices + i + 4))};
+            if(skipRestartIndex)
+            {
+                value0 = _mm_andnot_si128(_mm_cmpeq_epi32(value0, restartIndex), value0);
+                value1 = _mm_andnot_si128(_mm_cmpeq_epi32(value1, restartIndex), value1);
+            }
+            maxValue0 = getMaxEpu32(maxValue0, value0);
+            maxValue1 = getMaxEpu32(maxValue1, value1);
+        }
+        maxIndex = getHorizontalMax<GLuint>(getMaxEpu32(maxValue0, maxValue1));
+    }
+#endif
+
+    return std::max(maxIndex, getMaxIndexScalar(indices + i, count - i, skipRestartIndex));
+}
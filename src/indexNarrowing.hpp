@@ -0,0 +1,109 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "glad/glad.h"
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/// Largest index of the array. The primitive restart index, the largest value of the index type, is skipped if
+/// requested. The scan uses SSE2, and SSE4.1 for 32-bit indices, if the target supports it.
+auto getMaxIndex(GLubyte const * const indices, std::size_t const count, bool const skipRestartIndex) -> GLuint;
+auto getMaxIndex(GLushort const * const indices, std::size_t const count, bool const skipRestartIndex) -> GLuint;
+auto getMaxIndex(GLuint const * const indices, std::size_t const count, bool const skipRestartIndex) -> GLuint;
+
+template<typename TIndex>
+constexpr auto getIndexType( ) -> GLenum
+{
+    static_assert(
+        std::is_same_v<TIndex, GLubyte> || std::is_same_v<TIndex, GLushort> || std::is_same_v<TIndex, GLuint>,
+        "Indices are unsigned 8, 16 or 32-bit integers.");
+
+    if constexpr(std::is_same_v<TIndex, GLubyte>)
+    {
+        return GL_UNSIGNED_BYTE;
+    }
+    else if constexpr(std::is_same_v<TIndex, GLushort>)
+    {
+        return GL_UNSIGNED_SHORT;
+    }
+    else
+    {
+        return GL_UNSIGNED_INT;
+    }
+}
+
+constexpr auto getIndexSize(GLenum const type) -> GLsizeiptr
+{
+    switch(type)
+    {
+        // clang-format off
+        case GL_UNSIGNED_BYTE:  return sizeof(GLubyte);
+        case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+        default:                return sizeof(GLuint);
+        // clang-format on
+    }
+}
+
+/// Whether the largest index fits the index type. The largest value of the type is reserved for primitive restart.
+template<typename TIndex>
+constexpr auto isIndexInRange(GLuint const maxIndex, bool const primitiveRestart) -> bool
+{
+    constexpr GLuint k_maxValue{std::numeric_limits<TIndex>::max( )};
+    return primitiveRestart ? (maxIndex < k_maxValue) : (maxIndex <= k_maxValue);
+}
+
+/// Converts the indices to a narrower type, the restart indices are converted to the restart index of the target type.
+template<typename TTarget, typename TSource>
+auto narrowIndices(TSource const * const indices, std::size_t const count, bool const primitiveRestart)
+    -> std::vector<TTarget>
+{
+    constexpr TSource k_sourceRestartIndex{std::numeric_limits<TSource>::max( )};
+    constexpr TTarget k_targetRestartIndex{std::numeric_limits<TTarget>::max( )};
+
+    std::vector<TTarget> narrowed(count);
+    if(primitiveRestart)
+    {
+        for(std::size_t i{ }; i < count; ++i)
+        {
+            narrowed[i] =
+                (k_sourceRestartIndex == indices[i]) ? k_targetRestartIndex : static_cast<TTarget>(indices[i]);
+        }
+    }
+    else
+    {
+        for(std::size_t i{ }; i < count; ++i)
+        {
+            narrowed[i] = static_cast<TTarget>(indices[i]);
+        }
+    }
+    return narrowed;
+}
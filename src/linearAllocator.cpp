@@ -0,0 +1,119 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "linearAllocator.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+CLinearAllocator::CLinearAllocator(CLinearAllocator&& other)
+{
+    *this = std::move(other);
+}
+
+CLinearAllocator& CLinearAllocator::operator=(CLinearAllocator&& other)
+{
+    if(this != &other)
+    {
+        m_data          = std::move(other.m_data);
+        m_capacity      = std::exchange(other.m_capacity, { });
+        m_size          = std::exchange(other.m_size, { });
+        m_retiredBlocks = std::move(other.m_retiredBlocks);
+        m_retiredSize   = std::exchange(other.m_retiredSize, { });
+        m_peakSize      = std::exchange(other.m_peakSize, { });
+    }
+    return *this;
+}
+
+auto CLinearAllocator::create(std::size_t const capacity) -> void
+{
+    // The block is aligned for every fundamental type, stricter alignments are padded within the block
+    m_data     = std::make_unique<std::byte[]>(capacity);
+    m_capacity = capacity;
+    m_size     = { };
+    m_retiredBlocks.clear( );
+    m_retiredSize = { };
+    m_peakSize    = { };
+}
+
+auto CLinearAllocator::destroy( ) -> void
+{
+    m_data.reset( );
+    m_capacity = { };
+    m_size     = { };
+    m_retiredBlocks.clear( );
+    m_retiredSize = { };
+    m_peakSize    = { };
+}
+
+auto CLinearAllocator::allocate(std::size_t const size, std::size_t const alignment) -> void*
+{
+    std::uintptr_t const address{reinterpret_cast<std::uintptr_t>(m_data.get( )) + m_size};
+    std::size_t          padding{(alignment - (address % alignment)) % alignment};
+    if((m_size + padding + size) > m_capacity)
+    {
+        // Doubling the capacity makes a frame of the same size fit into a single block after a few frames
+        m_retiredSize += m_size;
+        m_retiredBlocks.push_back(std::move(m_data));
+        m_capacity = std::max(2 * m_capacity, size + alignment);
+        m_data     = std::make_unique<std::byte[]>(m_capacity);
+        m_size     = { };
+
+        padding = (alignment - (reinterpret_cast<std::uintptr_t>(m_data.get( )) % alignment)) % alignment;
+        spdlog::debug("Linear allocator grew to a block of {} bytes.", m_capacity);
+    }
+
+    void* const data{m_data.get( ) + m_size + padding};
+    m_size     += padding + size;
+    m_peakSize  = std::max(m_peakSize, m_retiredSize + m_size);
+    return data;
+}
+
+auto CLinearAllocator::reset( ) -> void
+{
+    m_size = { };
+    m_retiredBlocks.clear( );
+    m_retiredSize = { };
+}
+
+auto CLinearAllocator::getSize( ) const -> std::size_t
+{
+    return m_retiredSize + m_size;
+}
+
+auto CLinearAllocator::getCapacity( ) const -> std::size_t
+{
+    return m_capacity;
+}
+
+auto CLinearAllocator::getPeakSize( ) const -> std::size_t
+{
+    return m_peakSize;
+}
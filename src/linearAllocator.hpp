@@ -0,0 +1,84 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Bump allocator over a block of memory, released as a whole by reset( ), e.g. once per frame.
+///
+/// Allocating advances an offset and nothing is freed individually, so only trivially destructible objects are
+/// constructed in the block. A full block is retired and a block of at least twice its size takes over; the retired
+/// blocks keep the earlier allocations valid until the next reset, which releases them.
+class CLinearAllocator
+{
+public:
+    CLinearAllocator( ) = default;
+    ~CLinearAllocator( ) = default;
+
+    CLinearAllocator(CLinearAllocator const & other)            = delete;
+    CLinearAllocator& operator=(CLinearAllocator const & other) = delete;
+
+    CLinearAllocator(CLinearAllocator&& other);
+    CLinearAllocator& operator=(CLinearAllocator&& other);
+
+public:
+    auto create(std::size_t const capacity) -> void;
+    auto destroy( ) -> void;
+
+    auto allocate(std::size_t const size, std::size_t const alignment) -> void*;
+    template<typename T, typename... TArgs>
+    auto create(TArgs&&... args) -> T*;
+    auto reset( ) -> void;
+
+    auto getSize( ) const -> std::size_t;
+    /// Capacity of the current block, which grows until it holds everything allocated between two resets.
+    auto getCapacity( ) const -> std::size_t;
+    /// Largest size in use between two resets since the creation, in all blocks.
+    auto getPeakSize( ) const -> std::size_t;
+
+private:
+    std::unique_ptr<std::byte[]>              m_data{ };
+    std::size_t                               m_capacity{ };
+    std::size_t                               m_size{ };
+    std::vector<std::unique_ptr<std::byte[]>> m_retiredBlocks{ };
+    std::size_t                               m_retiredSize{ };
+    std::size_t                               m_peakSize{ };
+};
+
+template<typename T, typename... TArgs>
+auto CLinearAllocator::create(TArgs&&... args) -> T*
+{
+    static_assert(std::is_trivially_destructible_v<T>, "The linear allocator never calls destructors.");
+
+    return new(allocate(sizeof(T), alignof(T))) T{std::forward<TArgs>(args)...};
+}
@@ -26,13 +26,30 @@
 /// ----------------------------------------------------------------------------
 
 #include "program.hpp"
+#include "programBatch.hpp"
+#include "programBinaryCache.hpp"
+#include "renderQueue.hpp"
+#include "asyncUploader.hpp"
 #include "shader.hpp"
+#include "shaderWatcher.hpp"
 #include "error.hpp"
+#include "debugMessageQueue.hpp"
 #include "indexBuffer.hpp"
 #include "vertexBuffer.hpp"
 #include "vertexArray.hpp"
+#include "vertexArrayCache.hpp"
 #include "vertexBufferLayout.hpp"
-#include "stateVariables.hpp"
+#include "vertexInterleaver.hpp"
+#include "typedVertexBuffer.hpp"
+#include "uniformBlockBindings.hpp"
+#include "uniformBlockLayout.hpp"
+#include "uniformBufferRing.hpp"
+#include "deviceCaps.hpp"
+#include "stateCache.hpp"
+#include "stateAccess.hpp"
+#ifdef LEARNOGL_GL_TRACE
+#include "glCallTrace.hpp"
+#endif
 
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
@@ -42,12 +59,43 @@
 
 #include <iostream>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <algorithm>
+#include <string_view>
+#include <utility>
 
 // Window dimensions
 unsigned int const k_screenWidth{800};
 unsigned int const k_screenHeight{600};
 
+constexpr CUniformName k_objectData{"ObjectData"};
+constexpr CUniformName k_pointScale{"u_pointScale"};
+
+/// Per-draw data of the ObjectData block in assets/shader/objectData.glsl.
+struct CObjectData
+{
+    glm::vec4 m_color{ };
+};
+
+static_assert(isBlockLayout<EBlockLayout::Std140, glm::vec4>({offsetof(CObjectData, m_color)}));
+
+struct CVertex
+{
+    glm::vec2 m_position{ };
+    GLuint    m_pointSize{ };
+};
+
+template<>
+struct CStaticVertexBufferLayout<CVertex>
+{
+    static constexpr std::array k_elements{
+        LEARNOGL_VERTEX_BUFFER_ELEMENT(CVertex, m_position, EVertexAttributeIndex::Zero),
+        LEARNOGL_VERTEX_BUFFER_ELEMENT(CVertex, m_pointSize, EVertexAttributeIndex::One),
+    };
+};
+
 void               framebufferSizeCallback([[maybe_unused]] GLFWwindow* window, int width, int height)
 {
     GLCheck(glViewport(0, 0, width, height));
@@ -61,51 +109,16 @@ void processInput(GLFWwindow* window)
     }
 }
 
-auto printStateVariables( ) -> void
-{
-    CStateVariables::printInteger(GL_MAJOR_VERSION);
-    CStateVariables::printInteger(GL_MINOR_VERSION);
-    CStateVariables::printString(GL_VENDOR);
-    CStateVariables::printString(GL_RENDERER);
-    CStateVariables::printString(GL_VERSION);
-    CStateVariables::printString(GL_SHADING_LANGUAGE_VERSION);
-
-    CStateVariables::printInteger(GL_MAX_VERTEX_ATTRIBS);
-    CStateVariables::printInteger64(GL_MAX_ELEMENTS_VERTICES);
-    CStateVariables::printInteger64(GL_MAX_ELEMENTS_INDICES);
-    CStateVariables::printInteger(GL_MAX_DRAW_BUFFERS);
-    CStateVariables::printInteger64(GL_MAX_TEXTURE_BUFFER_SIZE);
-    CStateVariables::printInteger(GL_MAX_TEXTURE_IMAGE_UNITS);
-    CStateVariables::printInteger(GL_MAX_TEXTURE_SIZE);
-#ifdef __APPLE__
-#else
-    CStateVariables::printInteger(GL_MAX_UNIFORM_LOCATIONS);
-    CStateVariables::printInteger64(GL_MAX_ELEMENT_INDEX);
-#endif
-
-    CStateVariables::printPointSizeRange( );
-
-    CStateVariables::printInteger(GL_NUM_EXTENSIONS);
-    // CStateVariables::printExtensions( );
-
-    CStateVariables::printInteger(GL_MAX_VERTEX_UNIFORM_COMPONENTS);
-    CStateVariables::printInteger(GL_MAX_VERTEX_UNIFORM_VECTORS);
-    CStateVariables::printInteger(GL_MAX_VERTEX_UNIFORM_BLOCKS);
-
-    CStateVariables::printInteger(GL_MAX_FRAGMENT_UNIFORM_COMPONENTS);
-    CStateVariables::printInteger(GL_MAX_FRAGMENT_UNIFORM_VECTORS);
-    CStateVariables::printInteger(GL_MAX_FRAGMENT_UNIFORM_BLOCKS);
-
-    return;
-}
-
-auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
+auto main(int argc, char** argv) -> int
 {
     int glfwIsInitialized{GLFW_FALSE};
     int returnCode{ };
 
     try
     {
+        // Queue of the OpenGL debug messages, it has to outlive every OpenGL call
+        CDebugMessageQueue debugMessages{ };
+
         // Initialize GLFW
         glfwIsInitialized = glfwInit( );
         if(GLFW_FALSE == glfwIsInitialized)
@@ -121,9 +134,15 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
         // Specifies whether the OpenGL context should be forward-compatible, i.e. one where all functionality
         // deprecated in the requested version of OpenGL is removed.
         glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+#if LEARNOGL_GL_CHECK == LEARNOGL_GL_CHECK_OFF
+        // Specifies whether errors should be generated by the context. If enabled, situations that would have generated
+        // errors instead cause undefined behavior.
+        glfwWindowHint(GLFW_CONTEXT_NO_ERROR, GLFW_TRUE);
+#else
         // Specifies whether the context should be created in debug mode, which may provide additional error and
         // diagnostic reporting functionality.
         glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 
         // Create a window object
         GLFWwindow* window{glfwCreateWindow(k_screenWidth, k_screenHeight, "GLFW Example", nullptr, nullptr)};
@@ -139,10 +158,29 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
             throw std::runtime_error("Failed to initialize GLAD.");
         }
 
+#ifdef LEARNOGL_GL_TRACE
+        // Count and time every OpenGL call
+        CGLCallTrace::install( );
+#endif
+
+#if LEARNOGL_GL_CHECK != LEARNOGL_GL_CHECK_OFF
         // Enable OpenGL debug output
-        CError::enableDebugOutput( );
+        debugMessages.start( );
+        CError::enableDebugOutput(debugMessages);
+#endif
 
-        printStateVariables( );
+        // Snapshot the capabilities of the device, later startups on the same driver read them from the cache
+        CDeviceCaps deviceCaps{ };
+        deviceCaps.create("cache");
+        deviceCaps.print( );
+
+        // Restore the linked programs of earlier runs on the same driver
+        CProgramBinaryCache programBinaries{ };
+        programBinaries.create(deviceCaps, "cache");
+
+        // Edit the buffers and vertex arrays with direct state access unless the fallback is requested
+        bool const bindToEdit{std::find(argv + 1, argv + argc, std::string_view{"--bind-to-edit"}) != argv + argc};
+        CStateAccess::select(deviceCaps, !bindToEdit);
 
         // Set viewport size and register resize callback
         GLCheck(glViewport(0, 0, k_screenWidth, k_screenHeight));
@@ -170,56 +208,79 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
             // clang-format on
         };
 
-        struct CVertex
-        {
-            GLfloat m_x{ };
-            GLfloat m_y{ };
-            GLuint  m_ptSize{ };
-        };
-
         std::array<CVertex, 3> vertices{
-            {{-0.6f, -0.6f, 10}, {0.0f, 0.6f, 5}, {0.6f, -0.6f, 25}}
+            {{{-0.6f, -0.6f}, 10}, {{0.0f, 0.6f}, 5}, {{0.6f, -0.6f}, 25}}
         };
 
-        CVertexBuffer vbo{ };
-        vbo.create(positions.data( ), sizeof(GLfloat), positions.size( ));
-
-        CVertexBufferLayout vboLayout{ };
-        vboLayout.addFloat(EVertexAttributeIndex::Zero, ENumberOfComponents::Two);
+        CVertexBufferLayout positionsLayout{ };
+        positionsLayout.addFloat(EVertexAttributeIndex::Zero, ENumberOfComponents::Two);
 
-        CVertexBuffer vbPointSizes{ };
-        vbPointSizes.create(pointSizes.data( ), sizeof(GLfloat), pointSizes.size( ));
+        CVertexBufferLayout pointSizesLayout{ };
+        pointSizesLayout.addFloat(EVertexAttributeIndex::One, ENumberOfComponents::One);
 
-        CVertexBufferLayout vbPointSizesLayout{ };
-        vbPointSizesLayout.addFloat(EVertexAttributeIndex::One, ENumberOfComponents::One);
+        CInterleavedVertices const interleaved{CVertexInterleaver::interleave(
+            {{positions.data( ), &positionsLayout}, {pointSizes.data( ), &pointSizesLayout}}, pointSizes.size( ))};
 
-        CVertexBuffer vbVertices{ };
-        vbVertices.create(vertices.data( ), sizeof(CVertex), vertices.size( ));
+        // Upload the vertices on the loader thread while the other resources are created
+        CAsyncUploader uploader{ };
+        uploader.create(window);
+        CUploadHandle vertexUpload{uploader.upload(
+            interleaved.m_data.data( ), static_cast<GLsizeiptr>(interleaved.m_data.size( )))};
 
-        CVertexBufferLayout vbVerticesLayout{ };
-        vbVerticesLayout.addFloat(EVertexAttributeIndex::Zero, ENumberOfComponents::Two);
-        vbVerticesLayout.addUInt(EVertexAttributeIndex::One, ENumberOfComponents::One);
+        CTypedVertexBuffer<CVertex> vbVertices{ };
+        vbVertices.create(vertices);
 
         CIndexBuffer ibo{ };
         ibo.create(indicies.data( ), indicies.size( ));
 
-        CVertexArray vao{ };
-        vao.create( );
-        vao.addVertexBuffer(vbo, vboLayout);
-        vao.addVertexBuffer(vbPointSizes, vbPointSizesLayout);
-        // vao.addVertexBuffer(vbVertices, vbVerticesLayout);
-        vao.addIndexBuffer(ibo);
+        CVertexBuffer vbo{ };
+        vbo.adopt(vertexUpload.take( ));
+
+        // One vertex array per layout, the buffers of the mesh are attached before the draws
+        CVertexArrayCache vertexArrays{ };
+
+        // The batch compiles the programs in the background, the fallback is drawn until they are ready
+        CProgram fallbackProgram{ };
+        fallbackProgram.create(std::filesystem::path{"assets/shader/fallback.shader"}, &programBinaries);
+#if LEARNOGL_GL_CHECK != LEARNOGL_GL_CHECK_OFF
+        // Validation depends on the bound state, it is a debug check against the vertex array of the draws
+        CVertexArray& vao{vertexArrays.bind(interleaved.m_layout, vbo, ibo)};
+        fallbackProgram.validate( );
+        vao.unbind( );
+#endif
+
+        CProgramBatch programs{ };
+        programs.create(deviceCaps, reinterpret_cast<GLADloadproc>(glfwGetProcAddress), &programBinaries);
+        programs.setFallback(std::move(fallbackProgram));
+        std::filesystem::path const simpleShaderFilePath{"assets/shader/simple.shader"};
+        CProgramBatch::Handle const simpleProgram{programs.add(simpleShaderFilePath)};
 
-        CProgram program{ };
-        vao.bind();
-        program.create(std::filesystem::path{"assets/shader/simple.shader"});
-        vao.unbind();
+        // Edits of the shader files are compiled in the background and replace the programs once they are linked
+        CShaderWatcher shaderWatcher{ };
+        shaderWatcher.create( );
+        shaderWatcher.watch(simpleShaderFilePath);
+
+        // Per-draw uniform data is written to a ring of aligned slices in one uniform buffer
+        CUniformBufferRing objectUniforms{ };
+        objectUniforms.create(deviceCaps, 64 * 1024);
+        GLuint const objectDataBinding{CUniformBlockBindings::getBinding(k_objectData)};
+
+        CRenderQueue renderQueue{ };
+        renderQueue.create( );
 
         GLCheck(glEnable(GL_PROGRAM_POINT_SIZE));
 
+        // The uniform uploads are counted per frame and summed over the frames
+        CProgram::CUniformStatistics uniformStatistics{ };
+        std::uint64_t                numFrames{ };
+
         // Main rendering loop
         while(!glfwWindowShouldClose(window))
         {
+            // Collect the OpenGL errors of the whole frame in the deferred error checking mode
+            GLCheckScope("frame");
+            CProgram::resetUniformStatistics( );
+
             // Input handling
             processInput(window);
 
@@ -227,31 +288,91 @@ auto main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) -> int
             GLCheck(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
             GLCheck(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 
-            vao.bind( );
-            program.bind( );
-
-            program.setUniform("u_color", 1.0F, 0.0F, 0.0F, 1.0F);
-            GLCheck(glDrawArrays(GL_TRIANGLES, 0, 3));
-
-            program.setUniform("u_color", 0.0F, 1.0F, 0.0F, 1.0F);
-            GLCheck(glDrawArrays(GL_LINE_LOOP, 0, 3));
-
-            program.setUniform("u_color", 1.0F, 1.0F, 1.0F, 1.0F);
-            GLCheck(glDrawArrays(GL_POINTS, 0, 3));
-
-            // program.setUniform("u_color", 0.2F, 0.3F, 0.8F, 1.0F);
-            // GLCheck(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indicies.size( )), GL_UNSIGNED_INT, nullptr));
-
-            // program.setUniform("u_color", 0.8F, 0.3F, 0.8F, 1.0F);
-            // GLCheck(glDrawElements(GL_POINTS, static_cast<GLsizei>(indicies.size( )), GL_UNSIGNED_INT, nullptr));
-
-            program.unbind( );
-            vao.unbind( );
+            for(CShaderChange const & change : shaderWatcher.poll( ))
+            {
+                programs.reload(change.m_shaderFilePath, change.m_shaderSources, change.m_changeTime);
+            }
+            programs.poll( );
+
+            CVertexArray const & vertexArray{vertexArrays.bind(interleaved.m_layout, vbo, ibo)};
+            CProgram&            program{programs.getProgram(simpleProgram)};
+
+            // Set every frame like per-material state, the upload is skipped while the value is unchanged. A reloaded
+            // shader may no longer use the uniform, it is looked up instead of throwing for an inactive one.
+            CUniform const * const pointScale{program.findUniform(k_pointScale)};
+            if(nullptr != pointScale)
+            {
+                program.setUniform(pointScale->m_location, 2.0F);
+            }
+
+            // The draws are recorded with their uniform slices and executed in the order of their keys at the end of
+            // the frame, the last key field keeps the order of submission
+            CDrawPacket packet{ };
+            packet.m_program        = program.getId( );
+            packet.m_vertexArray    = vertexArray.getId( );
+            packet.m_count          = 3;
+            packet.m_uniformBinding = objectDataBinding;
+
+            packet.m_mode     = GL_TRIANGLES;
+            packet.m_uniforms = objectUniforms.push(CObjectData{{1.0F, 0.0F, 0.0F, 1.0F}});
+            renderQueue.submit(CRenderQueue::makeKey(0, packet.m_program, packet.m_vertexArray, 0), packet);
+
+            packet.m_mode     = GL_LINE_LOOP;
+            packet.m_uniforms = objectUniforms.push(CObjectData{{0.0F, 1.0F, 0.0F, 1.0F}});
+            renderQueue.submit(CRenderQueue::makeKey(0, packet.m_program, packet.m_vertexArray, 1), packet);
+
+            packet.m_mode     = GL_POINTS;
+            packet.m_uniforms = objectUniforms.push(CObjectData{{1.0F, 1.0F, 1.0F, 1.0F}});
+            renderQueue.submit(CRenderQueue::makeKey(0, packet.m_program, packet.m_vertexArray, 2), packet);
+
+            // packet.m_mode      = GL_TRIANGLES;
+            // packet.m_indexType = ibo.getType( );
+            // packet.m_count     = ibo.getCount( );
+            // packet.m_uniforms  = objectUniforms.push(CObjectData{{0.2F, 0.3F, 0.8F, 1.0F}});
+            // renderQueue.submit(CRenderQueue::makeKey(0, packet.m_program, packet.m_vertexArray, 3), packet);
+
+            renderQueue.flush( );
+            objectUniforms.endFrame( );
+
+            CProgram::CUniformStatistics const frameUniformStatistics{CProgram::getUniformStatistics( )};
+            uniformStatistics.m_numIssued  += frameUniformStatistics.m_numIssued;
+            uniformStatistics.m_numSkipped += frameUniformStatistics.m_numSkipped;
+            ++numFrames;
 
             // Swap the buffers and poll IO events
             glfwSwapBuffers(window);
             glfwPollEvents( );
+
+            // Throw the debug messages with the escalation severity outside of the driver callback
+            debugMessages.escalate( );
+
+#ifdef LEARNOGL_GL_TRACE
+            CGLCallTrace::endFrame( );
+#endif
         }
+
+        CStateCache::CStatistics const bindStatistics{CStateCache::get( ).getStatistics( )};
+        spdlog::info("Binds issued: {}, skipped: {}.", bindStatistics.m_numIssued, bindStatistics.m_numSkipped);
+
+        double const frameScale{(0 == numFrames) ? 0.0 : (1.0 / static_cast<double>(numFrames))};
+        spdlog::info(
+            "Uniform uploads per frame issued: {:.2f}, skipped: {:.2f}.",
+            frameScale * static_cast<double>(uniformStatistics.m_numIssued),
+            frameScale * static_cast<double>(uniformStatistics.m_numSkipped));
+
+        CVertexArrayCache::CStatistics const vertexArrayStatistics{vertexArrays.getStatistics( )};
+        spdlog::info(
+            "Vertex arrays: {}, hits: {}, misses: {}.", vertexArrays.getSize( ), vertexArrayStatistics.m_numHits,
+            vertexArrayStatistics.m_numMisses);
+        programBinaries.print( );
+        programs.print( );
+        renderQueue.print( );
+
+#ifdef LEARNOGL_GL_TRACE
+        CGLCallTrace::printFrameSummary( );
+        CGLCallTrace::writeChromeTrace(std::filesystem::path{"learn-opengl-trace.json"});
+        CGLCallTrace::uninstall( );
+#endif
     }
     catch(std::exception const & e)
     {
@@ -0,0 +1,196 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "mappedFile.hpp"
+
+#include "fmt/core.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <stdexcept>
+#include <utility>
+
+CMappedFile::~CMappedFile( )
+{
+    destroy( );
+}
+
+CMappedFile::CMappedFile(CMappedFile&& other)
+{
+    *this = std::move(other);
+}
+
+CMappedFile& CMappedFile::operator=(CMappedFile&& other)
+{
+    if(this != &other)
+    {
+        destroy( );
+        m_filePath = std::exchange(other.m_filePath, { });
+        m_data     = std::exchange(other.m_data, { });
+        m_size     = std::exchange(other.m_size, { });
+#ifdef _WIN32
+        m_file    = std::exchange(other.m_file, { });
+        m_mapping = std::exchange(other.m_mapping, { });
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+auto CMappedFile::create(std::filesystem::path const & filePath) -> void
+{
+    destroy( );
+
+    HANDLE const file{CreateFileW(
+        filePath.c_str( ), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr)};
+    LARGE_INTEGER size{ };
+    if((INVALID_HANDLE_VALUE == file) || !GetFileSizeEx(file, &size))
+    {
+        if(INVALID_HANDLE_VALUE != file)
+        {
+            CloseHandle(file);
+        }
+        throw std::runtime_error(fmt::format(R"(The file "{}" can not be opened.)", filePath.string( )));
+    }
+
+    m_filePath = filePath;
+    m_file     = file;
+    m_size     = static_cast<std::size_t>(size.QuadPart);
+    if(0 == m_size)
+    {
+        return;
+    }
+
+    m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(nullptr != m_mapping)
+    {
+        m_data = static_cast<char const *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    if(nullptr == m_data)
+    {
+        destroy( );
+        throw std::runtime_error(fmt::format(R"(The file "{}" can not be mapped.)", filePath.string( )));
+    }
+}
+
+auto CMappedFile::destroy( ) -> void
+{
+    if(nullptr != m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if(nullptr != m_mapping)
+    {
+        CloseHandle(m_mapping);
+    }
+    if(nullptr != m_file)
+    {
+        CloseHandle(m_file);
+    }
+    m_filePath.clear( );
+    m_data    = { };
+    m_size    = { };
+    m_file    = { };
+    m_mapping = { };
+}
+
+#else
+
+auto CMappedFile::create(std::filesystem::path const & filePath) -> void
+{
+    destroy( );
+
+    int const   file{open(filePath.c_str( ), O_RDONLY | O_CLOEXEC)};
+    struct stat status{ };
+    if((file < 0) || (0 != fstat(file, &status)))
+    {
+        if(file >= 0)
+        {
+            close(file);
+        }
+        throw std::runtime_error(fmt::format(R"(The file "{}" can not be opened.)", filePath.string( )));
+    }
+
+    m_filePath = filePath;
+    m_size     = static_cast<std::size_t>(status.st_size);
+    if(0 == m_size)
+    {
+        close(file);
+        return;
+    }
+
+    // The mapping keeps the file alive, the descriptor is not needed anymore
+    void* const data{mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0)};
+    close(file);
+    if(MAP_FAILED == data)
+    {
+        m_filePath.clear( );
+        m_size = { };
+        throw std::runtime_error(fmt::format(R"(The file "{}" can not be mapped.)", filePath.string( )));
+    }
+    // The file is scanned once from front to back
+    madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<char const *>(data);
+}
+
+auto CMappedFile::destroy( ) -> void
+{
+    if(nullptr != m_data)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+    m_filePath.clear( );
+    m_data = { };
+    m_size = { };
+}
+
+#endif
+
+auto CMappedFile::getView( ) const -> std::string_view
+{
+    return {m_data, m_size};
+}
+
+auto CMappedFile::getFilePath( ) const -> std::filesystem::path const &
+{
+    return m_filePath;
+}
@@ -0,0 +1,64 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+/// Read-only memory mapping of a whole file.
+///
+/// The view stays valid until the mapping is destroyed. An empty file maps to an empty view without a mapping.
+class CMappedFile
+{
+public:
+    CMappedFile( ) = default;
+    ~CMappedFile( );
+
+    CMappedFile(CMappedFile const & other)            = delete;
+    CMappedFile& operator=(CMappedFile const & other) = delete;
+
+    CMappedFile(CMappedFile&& other);
+    CMappedFile& operator=(CMappedFile&& other);
+
+public:
+    auto create(std::filesystem::path const & filePath) -> void;
+    auto destroy( ) -> void;
+
+    auto getView( ) const -> std::string_view;
+    auto getFilePath( ) const -> std::filesystem::path const &;
+
+private:
+    std::filesystem::path m_filePath{ };
+    char const *          m_data{ };
+    std::size_t           m_size{ };
+#ifdef _WIN32
+    void* m_file{ };
+    void* m_mapping{ };
+#endif
+};
@@ -0,0 +1,368 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "offsetAllocator.hpp"
+
+#include "fmt/core.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+constexpr std::uint32_t k_mantissaBits{3};
+constexpr std::uint32_t k_mantissaValue{1 << k_mantissaBits};
+constexpr std::uint32_t k_mantissaMask{k_mantissaValue - 1};
+constexpr std::uint32_t k_noSpace{~std::uint32_t{ }};
+
+auto countLeadingZeros(std::uint32_t const value) -> std::uint32_t
+{
+#ifdef _MSC_VER
+    unsigned long index{ };
+    return _BitScanReverse(&index, value) ? (31 - index) : 32;
+#else
+    return (0 == value) ? 32 : static_cast<std::uint32_t>(__builtin_clz(value));
+#endif
+}
+
+auto countTrailingZeros(std::uint32_t const value) -> std::uint32_t
+{
+#ifdef _MSC_VER
+    unsigned long index{ };
+    return _BitScanForward(&index, value) ? index : 32;
+#else
+    return (0 == value) ? 32 : static_cast<std::uint32_t>(__builtin_ctz(value));
+#endif
+}
+
+auto findLowestSetBitAfter(std::uint32_t const bitMask, std::uint32_t const startBitIndex) -> std::uint32_t
+{
+    if(startBitIndex >= 32)
+    {
+        return k_noSpace;
+    }
+    std::uint32_t const bitsAfter{bitMask & ~((std::uint32_t{1} << startBitIndex) - 1)};
+    return (0 == bitsAfter) ? k_noSpace : countTrailingZeros(bitsAfter);
+}
+
+// The sizes are encoded as small floating point numbers with 3 mantissa bits, which yields the bin index. Allocations
+// round up to the next bin, every range in it is large enough. Free ranges round down to the bin they fill completely.
+auto toBinIndex(std::uint32_t const size, bool const roundUp) -> std::uint32_t
+{
+    if(size < k_mantissaValue)
+    {
+        return size;
+    }
+
+    std::uint32_t const highestSetBit{31 - countLeadingZeros(size)};
+    std::uint32_t const mantissaStartBit{highestSetBit - k_mantissaBits};
+    std::uint32_t const exponent{mantissaStartBit + 1};
+    std::uint32_t       mantissa{(size >> mantissaStartBit) & k_mantissaMask};
+
+    std::uint32_t const lowBitsMask{(std::uint32_t{1} << mantissaStartBit) - 1};
+    if(roundUp && (0 != (size & lowBitsMask)))
+    {
+        // The carry into the exponent is intended
+        ++mantissa;
+    }
+    return (exponent << k_mantissaBits) + mantissa;
+}
+}
+
+auto COffsetAllocator::create(std::uint32_t const size, std::uint32_t const maxAllocations) -> void
+{
+    if(0 == maxAllocations)
+    {
+        throw std::runtime_error("The offset allocator requires at least one allocation.");
+    }
+    if(maxAllocations > ((k_unused - 1) / 2))
+    {
+        throw std::runtime_error(fmt::format("The offset allocator can not track {} allocations.", maxAllocations));
+    }
+
+    m_size           = size;
+    m_freeStorage    = { };
+    m_numAllocations = { };
+    m_usedBinsTop    = { };
+    m_usedBins.fill(0);
+    m_binIndices.fill(k_unused);
+
+    // Fragmentation leaves up to one free range around every allocation, N allocations need up to N + 1 free nodes
+    std::uint32_t const maxNodes{2 * maxAllocations + 1};
+    m_nodes.assign(maxNodes, CNode{ });
+    m_freeNodes.resize(maxNodes);
+    for(std::uint32_t i{ }; i < maxNodes; ++i)
+    {
+        m_freeNodes.at(i) = maxNodes - i - 1;
+    }
+
+    if(0 < size)
+    {
+        insertNodeIntoBin(size, 0);
+    }
+}
+
+auto COffsetAllocator::allocate(std::uint32_t const size) -> CAllocation
+{
+    if(m_freeNodes.empty( ))
+    {
+        return { };
+    }
+
+    std::uint32_t const minBinIndex{toBinIndex(size, true)};
+    std::uint32_t const minTopBinIndex{minBinIndex / k_numLeafBinsPerTopBin};
+    std::uint32_t const minLeafBinIndex{minBinIndex % k_numLeafBinsPerTopBin};
+
+    std::uint32_t topBinIndex{minTopBinIndex};
+    std::uint32_t leafBinIndex{k_noSpace};
+
+    // Search the top bin of the size first, the leaf bins below the size are too small
+    if(0 != (m_usedBinsTop & (std::uint32_t{1} << topBinIndex)))
+    {
+        leafBinIndex = findLowestSetBitAfter(m_usedBins.at(topBinIndex), minLeafBinIndex);
+    }
+
+    // Any leaf bin of a larger top bin fits
+    if(k_noSpace == leafBinIndex)
+    {
+        topBinIndex = findLowestSetBitAfter(m_usedBinsTop, minTopBinIndex + 1);
+        if(k_noSpace == topBinIndex)
+        {
+            return { };
+        }
+        leafBinIndex = countTrailingZeros(m_usedBins.at(topBinIndex));
+    }
+
+    std::uint32_t const binIndex{(topBinIndex * k_numLeafBinsPerTopBin) + leafBinIndex};
+    std::uint32_t const nodeIndex{m_binIndices.at(binIndex)};
+    CNode&              node{m_nodes.at(nodeIndex)};
+    std::uint32_t const nodeSize{node.m_size};
+
+    node.m_size   = size;
+    node.m_isUsed = true;
+
+    m_binIndices.at(binIndex) = node.m_binListNext;
+    if(k_unused != node.m_binListNext)
+    {
+        m_nodes.at(node.m_binListNext).m_binListPrevious = k_unused;
+    }
+    node.m_binListNext = k_unused;
+    m_freeStorage     -= nodeSize;
+    ++m_numAllocations;
+
+    if(k_unused == m_binIndices.at(binIndex))
+    {
+        m_usedBins.at(topBinIndex) &= static_cast<std::uint8_t>(~(1U << leafBinIndex));
+        if(0 == m_usedBins.at(topBinIndex))
+        {
+            m_usedBinsTop &= ~(std::uint32_t{1} << topBinIndex);
+        }
+    }
+
+    // The remainder of the range goes back into the bins, linked as the next neighbour
+    std::uint32_t const remainder{nodeSize - size};
+    if(0 < remainder)
+    {
+        std::uint32_t const remainderIndex{insertNodeIntoBin(remainder, m_nodes.at(nodeIndex).m_offset + size)};
+        CNode&              allocatedNode{m_nodes.at(nodeIndex)};
+        CNode&              remainderNode{m_nodes.at(remainderIndex)};
+
+        if(k_unused != allocatedNode.m_neighborNext)
+        {
+            m_nodes.at(allocatedNode.m_neighborNext).m_neighborPrevious = remainderIndex;
+        }
+        remainderNode.m_neighborPrevious = nodeIndex;
+        remainderNode.m_neighborNext     = allocatedNode.m_neighborNext;
+        allocatedNode.m_neighborNext     = remainderIndex;
+    }
+
+    return {m_nodes.at(nodeIndex).m_offset, nodeIndex};
+}
+
+auto COffsetAllocator::free(CAllocation const allocation) -> void
+{
+    if(k_invalidOffset == allocation.m_node)
+    {
+        return;
+    }
+
+    CNode& node{m_nodes.at(allocation.m_node)};
+    if(!node.m_isUsed)
+    {
+        throw std::runtime_error(fmt::format("The offset {} is freed twice.", allocation.m_offset));
+    }
+
+    std::uint32_t offset{node.m_offset};
+    std::uint32_t size{node.m_size};
+
+    // Merge with the free neighbours
+    if((k_unused != node.m_neighborPrevious) && !m_nodes.at(node.m_neighborPrevious).m_isUsed)
+    {
+        CNode const & previousNode{m_nodes.at(node.m_neighborPrevious)};
+        offset                   = previousNode.m_offset;
+        size                    += previousNode.m_size;
+
+        std::uint32_t const previousIndex{node.m_neighborPrevious};
+        node.m_neighborPrevious = previousNode.m_neighborPrevious;
+        removeNodeFromBin(previousIndex);
+    }
+    if((k_unused != node.m_neighborNext) && !m_nodes.at(node.m_neighborNext).m_isUsed)
+    {
+        CNode const & nextNode{m_nodes.at(node.m_neighborNext)};
+        size += nextNode.m_size;
+
+        std::uint32_t const nextIndex{node.m_neighborNext};
+        node.m_neighborNext = nextNode.m_neighborNext;
+        removeNodeFromBin(nextIndex);
+    }
+
+    std::uint32_t const neighborPrevious{node.m_neighborPrevious};
+    std::uint32_t const neighborNext{node.m_neighborNext};
+
+    node = { };
+    m_freeNodes.push_back(allocation.m_node);
+    --m_numAllocations;
+
+    std::uint32_t const combinedIndex{insertNodeIntoBin(size, offset)};
+    if(k_unused != neighborNext)
+    {
+        m_nodes.at(combinedIndex).m_neighborNext    = neighborNext;
+        m_nodes.at(neighborNext).m_neighborPrevious = combinedIndex;
+    }
+    if(k_unused != neighborPrevious)
+    {
+        m_nodes.at(combinedIndex).m_neighborPrevious = neighborPrevious;
+        m_nodes.at(neighborPrevious).m_neighborNext  = combinedIndex;
+    }
+}
+
+auto COffsetAllocator::getSize( ) const -> std::uint32_t
+{
+    return m_size;
+}
+
+auto COffsetAllocator::getAllocationSize(CAllocation const allocation) const -> std::uint32_t
+{
+    return (k_invalidOffset == allocation.m_node) ? 0 : m_nodes.at(allocation.m_node).m_size;
+}
+
+auto COffsetAllocator::getStorageReport( ) const -> CStorageReport
+{
+    CStorageReport report{ };
+    report.m_totalFree      = m_freeStorage;
+    report.m_numAllocations = m_numAllocations;
+    report.m_numFreeRegions =
+        static_cast<std::uint32_t>(m_nodes.size( ) - m_freeNodes.size( )) - m_numAllocations;
+
+    // The largest range is in the highest used bin, whose ranges differ by less than one bin width
+    if(0 != m_usedBinsTop)
+    {
+        std::uint32_t const topBinIndex{31 - countLeadingZeros(m_usedBinsTop)};
+        std::uint32_t const leafBinIndex{31 - countLeadingZeros(m_usedBins.at(topBinIndex))};
+        for(std::uint32_t nodeIndex{m_binIndices.at((topBinIndex * k_numLeafBinsPerTopBin) + leafBinIndex)};
+            k_unused != nodeIndex; nodeIndex = m_nodes.at(nodeIndex).m_binListNext)
+        {
+            report.m_largestFree = std::max(report.m_largestFree, m_nodes.at(nodeIndex).m_size);
+        }
+    }
+    return report;
+}
+
+auto COffsetAllocator::insertNodeIntoBin(std::uint32_t const size, std::uint32_t const offset) -> std::uint32_t
+{
+    std::uint32_t const binIndex{toBinIndex(size, false)};
+    std::uint32_t const topBinIndex{binIndex / k_numLeafBinsPerTopBin};
+    std::uint32_t const leafBinIndex{binIndex % k_numLeafBinsPerTopBin};
+
+    if(k_unused == m_binIndices.at(binIndex))
+    {
+        m_usedBins.at(topBinIndex) |= static_cast<std::uint8_t>(1U << leafBinIndex);
+        m_usedBinsTop              |= std::uint32_t{1} << topBinIndex;
+    }
+
+    std::uint32_t const headIndex{m_binIndices.at(binIndex)};
+    std::uint32_t const nodeIndex{m_freeNodes.back( )};
+    m_freeNodes.pop_back( );
+
+    CNode& node{m_nodes.at(nodeIndex)};
+    node               = { };
+    node.m_offset      = offset;
+    node.m_size        = size;
+    node.m_binListNext = headIndex;
+    if(k_unused != headIndex)
+    {
+        m_nodes.at(headIndex).m_binListPrevious = nodeIndex;
+    }
+    m_binIndices.at(binIndex) = nodeIndex;
+
+    m_freeStorage += size;
+    return nodeIndex;
+}
+
+auto COffsetAllocator::removeNodeFromBin(std::uint32_t const nodeIndex) -> void
+{
+    CNode const & node{m_nodes.at(nodeIndex)};
+
+    if(k_unused != node.m_binListPrevious)
+    {
+        m_nodes.at(node.m_binListPrevious).m_binListNext = node.m_binListNext;
+        if(k_unused != node.m_binListNext)
+        {
+            m_nodes.at(node.m_binListNext).m_binListPrevious = node.m_binListPrevious;
+        }
+    }
+    else
+    {
+        // The node is the head of its bin
+        std::uint32_t const binIndex{toBinIndex(node.m_size, false)};
+        std::uint32_t const topBinIndex{binIndex / k_numLeafBinsPerTopBin};
+        std::uint32_t const leafBinIndex{binIndex % k_numLeafBinsPerTopBin};
+
+        m_binIndices.at(binIndex) = node.m_binListNext;
+        if(k_unused != node.m_binListNext)
+        {
+            m_nodes.at(node.m_binListNext).m_binListPrevious = k_unused;
+        }
+
+        if(k_unused == m_binIndices.at(binIndex))
+        {
+            m_usedBins.at(topBinIndex) &= static_cast<std::uint8_t>(~(1U << leafBinIndex));
+            if(0 == m_usedBins.at(topBinIndex))
+            {
+                m_usedBinsTop &= ~(std::uint32_t{1} << topBinIndex);
+            }
+        }
+    }
+
+    m_freeStorage -= node.m_size;
+    m_nodes.at(nodeIndex) = { };
+    m_freeNodes.push_back(nodeIndex);
+}
@@ -0,0 +1,97 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// Two-level segregated fit allocator of offsets into an external resource, e.g. a range of a buffer object.
+///
+/// Free ranges are kept in 256 size classes (32 exponents with 8 linear steps each) indexed by two bitmasks, so
+/// allocating and freeing take constant time. Freeing merges the range with its free neighbours.
+class COffsetAllocator
+{
+public:
+    static constexpr std::uint32_t k_invalidOffset{~std::uint32_t{ }};
+    static constexpr std::uint32_t k_defaultMaxAllocations{128 * 1024};
+
+    struct CAllocation
+    {
+        std::uint32_t m_offset{k_invalidOffset};
+        std::uint32_t m_node{k_invalidOffset};
+    };
+
+    struct CStorageReport
+    {
+        std::uint32_t m_totalFree{ };
+        std::uint32_t m_largestFree{ };
+        std::uint32_t m_numFreeRegions{ };
+        std::uint32_t m_numAllocations{ };
+    };
+
+public:
+    auto create(std::uint32_t const size, std::uint32_t const maxAllocations = k_defaultMaxAllocations) -> void;
+
+    auto allocate(std::uint32_t const size) -> CAllocation;
+    auto free(CAllocation const allocation) -> void;
+
+    auto getSize( ) const -> std::uint32_t;
+    auto getAllocationSize(CAllocation const allocation) const -> std::uint32_t;
+    auto getStorageReport( ) const -> CStorageReport;
+
+private:
+    static constexpr std::uint32_t k_numTopBins{32};
+    static constexpr std::uint32_t k_numLeafBinsPerTopBin{8};
+    static constexpr std::uint32_t k_numLeafBins{k_numTopBins * k_numLeafBinsPerTopBin};
+    static constexpr std::uint32_t k_unused{~std::uint32_t{ }};
+
+    struct CNode
+    {
+        std::uint32_t m_offset{ };
+        std::uint32_t m_size{ };
+        std::uint32_t m_binListPrevious{k_unused};
+        std::uint32_t m_binListNext{k_unused};
+        std::uint32_t m_neighborPrevious{k_unused};
+        std::uint32_t m_neighborNext{k_unused};
+        bool          m_isUsed{ };
+    };
+
+    auto insertNodeIntoBin(std::uint32_t const size, std::uint32_t const offset) -> std::uint32_t;
+    auto removeNodeFromBin(std::uint32_t const nodeIndex) -> void;
+
+private:
+    std::uint32_t                            m_size{ };
+    std::uint32_t                            m_freeStorage{ };
+    std::uint32_t                            m_numAllocations{ };
+    std::uint32_t                            m_usedBinsTop{ };
+    std::array<std::uint8_t, k_numTopBins>   m_usedBins{ };
+    std::array<std::uint32_t, k_numLeafBins> m_binIndices{ };
+    std::vector<CNode>                       m_nodes{ };
+    std::vector<std::uint32_t>               m_freeNodes{ };
+};
@@ -27,14 +27,85 @@
 
 #include "program.hpp"
 #include "error.hpp"
+#include "stateCache.hpp"
 #include "shaderParser.hpp"
 #include "shader.hpp"
+#include "programBinaryCache.hpp"
+#include "uniformBlockBindings.hpp"
+#include "hash.hpp"
 
 #include "fmt/core.h"
+#include "glm/gtc/type_ptr.hpp"
 
 #include <utility>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+
+namespace
+{
+struct CUniformComponents
+{
+    GLenum m_type{ };
+    GLint  m_count{ };
+};
+
+/// Components of the values of a uniform type. Double types are not shadowed and have no components.
+auto getUniformComponents(GLenum const type) -> CUniformComponents
+{
+    switch(type)
+    {
+    case GL_FLOAT:             return {GL_FLOAT, 1};
+    case GL_FLOAT_VEC2:        return {GL_FLOAT, 2};
+    case GL_FLOAT_VEC3:        return {GL_FLOAT, 3};
+    case GL_FLOAT_VEC4:        return {GL_FLOAT, 4};
+    case GL_FLOAT_MAT2:        return {GL_FLOAT, 4};
+    case GL_FLOAT_MAT3:        return {GL_FLOAT, 9};
+    case GL_FLOAT_MAT4:        return {GL_FLOAT, 16};
+    case GL_FLOAT_MAT2x3:      return {GL_FLOAT, 6};
+    case GL_FLOAT_MAT3x2:      return {GL_FLOAT, 6};
+    case GL_FLOAT_MAT2x4:      return {GL_FLOAT, 8};
+    case GL_FLOAT_MAT4x2:      return {GL_FLOAT, 8};
+    case GL_FLOAT_MAT3x4:      return {GL_FLOAT, 12};
+    case GL_FLOAT_MAT4x3:      return {GL_FLOAT, 12};
+    case GL_INT:               return {GL_INT, 1};
+    case GL_INT_VEC2:          return {GL_INT, 2};
+    case GL_INT_VEC3:          return {GL_INT, 3};
+    case GL_INT_VEC4:          return {GL_INT, 4};
+    case GL_BOOL:              return {GL_INT, 1};
+    case GL_BOOL_VEC2:         return {GL_INT, 2};
+    case GL_BOOL_VEC3:         return {GL_INT, 3};
+    case GL_BOOL_VEC4:         return {GL_INT, 4};
+    case GL_UNSIGNED_INT:      return {GL_UNSIGNED_INT, 1};
+    case GL_UNSIGNED_INT_VEC2: return {GL_UNSIGNED_INT, 2};
+    case GL_UNSIGNED_INT_VEC3: return {GL_UNSIGNED_INT, 3};
+    case GL_UNSIGNED_INT_VEC4: return {GL_UNSIGNED_INT, 4};
+    case GL_DOUBLE:
+    case GL_DOUBLE_VEC2:
+    case GL_DOUBLE_VEC3:
+    case GL_DOUBLE_VEC4:
+    case GL_DOUBLE_MAT2:
+    case GL_DOUBLE_MAT3:
+    case GL_DOUBLE_MAT4:
+    case GL_DOUBLE_MAT2x3:
+    case GL_DOUBLE_MAT3x2:
+    case GL_DOUBLE_MAT2x4:
+    case GL_DOUBLE_MAT4x2:
+    case GL_DOUBLE_MAT3x4:
+    case GL_DOUBLE_MAT4x3:     return {GL_DOUBLE, 0};
+    // Samplers and images are set as texture and image units
+    default:                   return {GL_INT, 1};
+    }
+}
+
+CProgram::CUniformStatistics s_uniformStatistics{ };
+} // namespace
 
 CProgram::CProgram( )
 {
@@ -55,8 +126,11 @@ CProgram& CProgram::operator=(CProgram&& other)
     if(this != &other)
     {
         destroy( );
-        m_programId            = std::exchange(other.m_programId, { });
-        m_uniformLocationCache = std::exchange(other.m_uniformLocationCache, { });
+        m_programId      = std::exchange(other.m_programId, { });
+        m_uniforms       = std::exchange(other.m_uniforms, { });
+        m_uniformShadows = std::exchange(other.m_uniformShadows, { });
+        m_uniformValues  = std::exchange(other.m_uniformValues, { });
+        m_uniformBlocks  = std::exchange(other.m_uniformBlocks, { });
     }
     return *this;
 }
@@ -68,50 +142,357 @@ auto CProgram::getId( ) const -> GLuint
 
 auto CProgram::bind( ) const -> void
 {
-    GLCheck(glUseProgram(m_programId));
+    CStateCache::get( ).useProgram(m_programId);
 }
 
 auto CProgram::unbind( ) const -> void
 {
-    GLCheck(glUseProgram(0));
+    CStateCache::get( ).useProgram(0);
+}
+
+auto CProgram::validate( ) const -> void
+{
+    GLCheck(glValidateProgram(m_programId));
+    checkStatus(GL_VALIDATE_STATUS);
+}
+
+auto CProgram::getUniforms( ) const -> std::vector<CUniform> const &
+{
+    return m_uniforms;
+}
+
+auto CProgram::findUniform(CUniformName const name) const -> CUniform const *
+{
+    auto const iter{std::lower_bound(
+        m_uniforms.begin( ),
+        m_uniforms.end( ),
+        name.m_hash,
+        [](CUniform const & uniform, std::uint64_t const hash) { return uniform.m_hash < hash; })};
+    if((iter == m_uniforms.end( )) || (iter->m_hash != name.m_hash))
+    {
+        return nullptr;
+    }
+    return &*iter;
+}
+
+auto CProgram::hasUniform(CUniformName const name) const -> bool
+{
+    return nullptr != findUniform(name);
+}
+
+auto CProgram::getUniformBlocks( ) const -> std::vector<CUniformBlock> const &
+{
+    return m_uniformBlocks;
+}
+
+auto CProgram::findUniformBlock(CUniformName const name) const -> CUniformBlock const *
+{
+    auto const iter{std::lower_bound(
+        m_uniformBlocks.begin( ),
+        m_uniformBlocks.end( ),
+        name.m_hash,
+        [](CUniformBlock const & uniformBlock, std::uint64_t const hash) { return uniformBlock.m_hash < hash; })};
+    if((iter == m_uniformBlocks.end( )) || (iter->m_hash != name.m_hash))
+    {
+        return nullptr;
+    }
+    return &*iter;
+}
+
+auto CProgram::getUniformLocation(CUniformName const name) const -> GLint
+{
+    CUniform const * const uniform{findUniform(name)};
+    if(nullptr == uniform)
+    {
+        throw std::out_of_range(fmt::format("The uniform variable with the hash {:#018x} is not active.", name.m_hash));
+    }
+    return uniform->m_location;
+}
+
+auto CProgram::getUniformLocation(std::string const & name) const -> GLint
+{
+    CUniform const * const uniform{findUniform(CUniformName{name})};
+    if(nullptr == uniform)
+    {
+        throw std::out_of_range(fmt::format(R"(Location of the uniform variable "{}" can not be found.)", name));
+    }
+    return uniform->m_location;
 }
 
 auto CProgram::setUniform(std::string const & name, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) -> void
 {
-    GLint const location{getUniformLocation(name)};
-    GLCheck(glUniform4f(location, v0, v1, v2, v3));
+    setUniform(getUniformLocation(name), glm::vec4{v0, v1, v2, v3});
+}
+
+auto CProgram::setUniforms(GLint const location, GLfloat const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(GLfloat) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform1fv(m_programId, location, count, values));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::vec2 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::vec2) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform2fv(m_programId, location, count, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::vec3 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::vec3) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform3fv(m_programId, location, count, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::vec4 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::vec4) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform4fv(m_programId, location, count, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, GLint const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(GLint) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform1iv(m_programId, location, count, values));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::ivec2 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::ivec2) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform2iv(m_programId, location, count, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::ivec3 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::ivec3) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform3iv(m_programId, location, count, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::ivec4 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::ivec4) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform4iv(m_programId, location, count, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, GLuint const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(GLuint) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform1uiv(m_programId, location, count, values));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::uvec2 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::uvec2) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform2uiv(m_programId, location, count, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::uvec3 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::uvec3) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform3uiv(m_programId, location, count, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::uvec4 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::uvec4) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniform4uiv(m_programId, location, count, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::mat2 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::mat2) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniformMatrix2fv(m_programId, location, count, GL_FALSE, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::mat3 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::mat3) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniformMatrix3fv(m_programId, location, count, GL_FALSE, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::mat4 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::mat4) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniformMatrix4fv(m_programId, location, count, GL_FALSE, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::mat2x3 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::mat2x3) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniformMatrix2x3fv(m_programId, location, count, GL_FALSE, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::mat3x2 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::mat3x2) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniformMatrix3x2fv(m_programId, location, count, GL_FALSE, glm::value_ptr(*values)));
+    }
+}
+
+auto CProgram::setUniforms(GLint const location, glm::mat2x4 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::mat2x4) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniformMatrix2x4fv(m_programId, location, count, GL_FALSE, glm::value_ptr(*values)));
+    }
 }
 
-auto CProgram::getUniformLocation(std::string const & name) -> GLint
+auto CProgram::setUniforms(GLint const location, glm::mat4x2 const * values, GLsizei const count) -> void
 {
-    auto const iter{m_uniformLocationCache.find(name)};
-    if(iter != m_uniformLocationCache.end( ))
+    if(updateShadow(location, values, sizeof(glm::mat4x2) * static_cast<std::size_t>(count)))
     {
-        return std::get<1>(*iter);
+        GLCheck(glProgramUniformMatrix4x2fv(m_programId, location, count, GL_FALSE, glm::value_ptr(*values)));
     }
+}
 
-    GLCheck(GLint const location = glGetUniformLocation(m_programId, name.c_str( )));
-    if(-1 == location)
+auto CProgram::setUniforms(GLint const location, glm::mat3x4 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::mat3x4) * static_cast<std::size_t>(count)))
     {
-        throw std::runtime_error(fmt::format(R"(Location of the uniform variable "{}" can not be found.)", name));
+        GLCheck(glProgramUniformMatrix3x4fv(m_programId, location, count, GL_FALSE, glm::value_ptr(*values)));
     }
+}
 
-    m_uniformLocationCache.insert_or_assign(name, location);
-    return location;
+auto CProgram::setUniforms(GLint const location, glm::mat4x3 const * values, GLsizei const count) -> void
+{
+    if(updateShadow(location, values, sizeof(glm::mat4x3) * static_cast<std::size_t>(count)))
+    {
+        GLCheck(glProgramUniformMatrix4x3fv(m_programId, location, count, GL_FALSE, glm::value_ptr(*values)));
+    }
 }
 
-auto CProgram::create(std::filesystem::path const & shaderFilePath) -> void
+auto CProgram::getUniformStatistics( ) -> CUniformStatistics
+{
+    return s_uniformStatistics;
+}
+
+auto CProgram::resetUniformStatistics( ) -> void
+{
+    s_uniformStatistics = { };
+}
+
+auto CProgram::create(
+    std::filesystem::path const & shaderFilePath,
+    CProgramBinaryCache* const    binaryCache,
+    std::string_view const        defines) -> void
 {
     destroy( );
 
     CShaderParser parser{ };
-    parser.parse(shaderFilePath);
+    parser.parse(shaderFilePath, defines);
+
+    build(parser.getShaderSources( ), binaryCache, false);
+}
+
+auto CProgram::createSeparable(CShaderSource const & shaderSource, CProgramBinaryCache* const binaryCache) -> void
+{
+    destroy( );
+
+    build({shaderSource}, binaryCache, true);
+}
+
+auto CProgram::destroy( ) -> void
+{
+    if(0 != m_programId)
+    {
+        GLCheck(glDeleteProgram(m_programId));
+        CStateCache::get( ).forgetProgram(m_programId);
+        m_programId = { };
+    }
+    m_uniforms.clear( );
+    m_uniformShadows.clear( );
+    m_uniformValues.clear( );
+    m_uniformBlocks.clear( );
+}
+
+auto CProgram::adopt(GLuint const programId) -> void
+{
+    destroy( );
+    m_programId = programId;
 
-    CShader vertexShader{ };
-    vertexShader.create(EShaderType::Vertex, parser.getVertexShaderSource( ));
+    if(0 != m_programId)
+    {
+        reflectUniforms( );
+        reflectUniformBlocks( );
+    }
+}
 
-    CShader fragmentShader{ };
-    fragmentShader.create(EShaderType::Fragment, parser.getFragmentShaderSource( ));
+auto CProgram::build(
+    std::vector<CShaderSource> const & shaderSources,
+    CProgramBinaryCache* const         binaryCache,
+    bool const                         separable) -> void
+{
+    bool const    isCacheEnabled{(nullptr != binaryCache) && binaryCache->isEnabled( )};
+    std::uint64_t key{ };
+    bool          isCached{ };
+    if(isCacheEnabled)
+    {
+        // The binary keeps the separable state, a separable stage must not be restored as a complete program
+        key = binaryCache->getKey(shaderSources);
+        key = separable ? fnv1a(std::string_view{"separable"}, key) : key;
+
+        GLCheck(m_programId = glCreateProgram( ));
+        isCached = (0 != m_programId) && binaryCache->load(m_programId, key);
+        if(!isCached)
+        {
+            // The program of a rejected binary stays unlinked, the compilation starts with a new program
+            destroy( );
+        }
+    }
+
+    if(!isCached)
+    {
+        auto const start{std::chrono::steady_clock::now( )};
+        link(shaderSources, isCacheEnabled, separable);
+        if(isCacheEnabled)
+        {
+            binaryCache->save(m_programId, key, std::chrono::steady_clock::now( ) - start);
+        }
+    }
+
+    reflectUniforms( );
+    reflectUniformBlocks( );
+}
+
+auto CProgram::link(std::vector<CShaderSource> const & shaderSources, bool const retrievable, bool const separable)
+    -> void
+{
+    std::vector<CShader> shaders(shaderSources.size( ));
+    for(std::size_t i{ }; i < shaderSources.size( ); ++i)
+    {
+        shaders.at(i).create(shaderSources.at(i).m_shaderType, shaderSources.at(i).m_source);
+    }
 
     GLCheck(m_programId = glCreateProgram( ));
     if(0 == m_programId)
@@ -119,13 +500,28 @@ auto CProgram::create(std::filesystem::path const & shaderFilePath) -> void
         throw std::runtime_error("glCreateProgram returned zero.");
     }
 
-    GLCheck(glAttachShader(m_programId, vertexShader.getId( )));
-    GLCheck(glAttachShader(m_programId, fragmentShader.getId( )));
+    for(CShader const & shader : shaders)
+    {
+        GLCheck(glAttachShader(m_programId, shader.getId( )));
+    }
+    if(retrievable)
+    {
+        GLCheck(glProgramParameteri(m_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+    if(separable)
+    {
+        GLCheck(glProgramParameteri(m_programId, GL_PROGRAM_SEPARABLE, GL_TRUE));
+    }
 
-    GLint programLinked{ };
     GLCheck(glLinkProgram(m_programId));
-    GLCheck(glGetProgramiv(m_programId, GL_LINK_STATUS, &programLinked));
-    if(programLinked != GL_TRUE)
+    checkStatus(GL_LINK_STATUS);
+}
+
+auto CProgram::checkStatus(GLenum const status) const -> void
+{
+    GLint result{ };
+    GLCheck(glGetProgramiv(m_programId, status, &result));
+    if(result != GL_TRUE)
     {
         GLint logLength{ };
         GLCheck(glGetProgramiv(m_programId, GL_INFO_LOG_LENGTH, &logLength));
@@ -136,29 +532,234 @@ auto CProgram::create(std::filesystem::path const & shaderFilePath) -> void
 
         throw std::runtime_error(message);
     }
+}
 
-    GLint validationStatus{ };
-    GLCheck(glValidateProgram(m_programId));
-    GLCheck(glGetProgramiv(m_programId, GL_VALIDATE_STATUS, &validationStatus));
-    if(validationStatus != GL_TRUE)
+auto CProgram::reflectUniforms( ) -> void
+{
+    m_uniforms.clear( );
+    m_uniformShadows.clear( );
+    m_uniformValues.clear( );
+
+    if((nullptr != glad_glGetProgramInterfaceiv) && (nullptr != glad_glGetProgramResourceiv) &&
+       (nullptr != glad_glGetProgramResourceName))
     {
-        GLint logLength{ };
-        GLCheck(glGetProgramiv(m_programId, GL_INFO_LOG_LENGTH, &logLength));
+        GLint numUniforms{ };
+        GLint maxNameLength{ };
+        GLCheck(glGetProgramInterfaceiv(m_programId, GL_UNIFORM, GL_ACTIVE_RESOURCES, &numUniforms));
+        GLCheck(glGetProgramInterfaceiv(m_programId, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength));
 
-        std::string message{ };
-        message.resize(logLength);
-        GLCheck(glGetProgramInfoLog(m_programId, logLength, &logLength, message.data( )));
+        constexpr std::array<GLenum, 4> k_properties{GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION, GL_BLOCK_INDEX};
 
-        throw std::runtime_error(message);
+        std::string name(static_cast<std::size_t>(std::max(maxNameLength, 1)), '\0');
+        for(GLint i{ }; i < numUniforms; ++i)
+        {
+            std::array<GLint, k_properties.size( )> values{ };
+            GLCheck(glGetProgramResourceiv(
+                m_programId,
+                GL_UNIFORM,
+                i,
+                static_cast<GLsizei>(k_properties.size( )),
+                k_properties.data( ),
+                static_cast<GLsizei>(values.size( )),
+                nullptr,
+                values.data( )));
+
+            // Members of uniform blocks are set through buffers, atomic counters have no location either
+            if((-1 != values.at(3)) || (-1 == values.at(2)))
+            {
+                continue;
+            }
+
+            GLsizei length{ };
+            GLCheck(glGetProgramResourceName(
+                m_programId, GL_UNIFORM, i, static_cast<GLsizei>(name.size( )), &length, name.data( )));
+            addUniform(name.substr(0, length), static_cast<GLenum>(values.at(0)), values.at(1), values.at(2));
+        }
     }
+    else
+    {
+        GLint numUniforms{ };
+        GLint maxNameLength{ };
+        GLCheck(glGetProgramiv(m_programId, GL_ACTIVE_UNIFORMS, &numUniforms));
+        GLCheck(glGetProgramiv(m_programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength));
+
+        std::string name(static_cast<std::size_t>(std::max(maxNameLength, 1)), '\0');
+        for(GLint i{ }; i < numUniforms; ++i)
+        {
+            GLsizei length{ };
+            GLint   arraySize{ };
+            GLenum  type{ };
+            GLCheck(glGetActiveUniform(
+                m_programId, i, static_cast<GLsizei>(name.size( )), &length, &arraySize, &type, name.data( )));
+
+            // Members of uniform blocks have no location
+            GLCheck(GLint const location = glGetUniformLocation(m_programId, name.c_str( )));
+            if(-1 == location)
+            {
+                continue;
+            }
+            addUniform(name.substr(0, length), type, arraySize, location);
+        }
+    }
+
+    std::sort(
+        m_uniforms.begin( ),
+        m_uniforms.end( ),
+        [](CUniform const & lhs, CUniform const & rhs) { return lhs.m_hash < rhs.m_hash; });
+
+    auto const iter{std::adjacent_find(
+        m_uniforms.begin( ),
+        m_uniforms.end( ),
+        [](CUniform const & lhs, CUniform const & rhs) { return lhs.m_hash == rhs.m_hash; })};
+    if(iter != m_uniforms.end( ))
+    {
+        throw std::runtime_error(fmt::format(
+            R"(The uniform variables "{}" and "{}" have the same hash.)", iter->m_name, std::next(iter)->m_name));
+    }
+
+    readUniformValues( );
 }
 
-auto CProgram::destroy( ) -> void
+auto CProgram::addUniform(std::string name, GLenum const type, GLint const arraySize, GLint const location) -> void
 {
-    if(0 != m_programId)
+    // Arrays are reported with the name of their first element
+    constexpr std::string_view k_firstElement{"[0]"};
+    if(std::string_view{name}.substr(name.size( ) - std::min(name.size( ), k_firstElement.size( ))) == k_firstElement)
     {
-        GLCheck(glDeleteProgram(m_programId));
-        m_programId = { };
+        name.resize(name.size( ) - k_firstElement.size( ));
     }
-    m_uniformLocationCache.clear( );
+
+    std::uint64_t const hash{CUniformName{name}.m_hash};
+    m_uniforms.push_back(CUniform{hash, std::move(name), type, arraySize, location});
+}
+
+auto CProgram::readUniformValues( ) -> void
+{
+    // Writes may start at any element of an array, every element location gets a shadow entry that covers the bytes
+    // from the element to the end of the array
+    std::vector<std::pair<GLint, CUniformShadow>> shadows{ };
+    for(CUniform const & uniform : m_uniforms)
+    {
+        CUniformComponents const components{getUniformComponents(uniform.m_type)};
+        if(0 == components.m_count)
+        {
+            continue;
+        }
+
+        std::size_t const elementSize{sizeof(GLint) * static_cast<std::size_t>(components.m_count)};
+        std::size_t const offset{m_uniformValues.size( )};
+        std::size_t const size{elementSize * static_cast<std::size_t>(uniform.m_arraySize)};
+        m_uniformValues.resize(offset + size);
+
+        for(GLint i{ }; i < uniform.m_arraySize; ++i)
+        {
+            // The locations of the elements are not guaranteed to follow the location of the first one
+            GLint location{uniform.m_location};
+            if(0 != i)
+            {
+                std::string const elementName{fmt::format("{}[{}]", uniform.m_name, i)};
+                GLCheck(location = glGetUniformLocation(m_programId, elementName.c_str( )));
+            }
+            if(location < 0)
+            {
+                continue;
+            }
+
+            std::size_t const elementOffset{offset + elementSize * static_cast<std::size_t>(i)};
+            std::size_t const elementsSize{offset + size - elementOffset};
+            shadows.emplace_back(
+                location,
+                CUniformShadow{static_cast<std::uint32_t>(elementOffset), static_cast<std::uint32_t>(elementsSize)});
+
+            void* const value{m_uniformValues.data( ) + elementOffset};
+            switch(components.m_type)
+            {
+            case GL_FLOAT:        GLCheck(glGetUniformfv(m_programId, location, static_cast<GLfloat*>(value))); break;
+            case GL_UNSIGNED_INT: GLCheck(glGetUniformuiv(m_programId, location, static_cast<GLuint*>(value))); break;
+            default:              GLCheck(glGetUniformiv(m_programId, location, static_cast<GLint*>(value))); break;
+            }
+        }
+    }
+
+    GLint maxLocation{-1};
+    for(std::pair<GLint, CUniformShadow> const & shadow : shadows)
+    {
+        maxLocation = std::max(maxLocation, shadow.first);
+    }
+    m_uniformShadows.assign(static_cast<std::size_t>(maxLocation + 1), { });
+    for(std::pair<GLint, CUniformShadow> const & shadow : shadows)
+    {
+        m_uniformShadows.at(static_cast<std::size_t>(shadow.first)) = shadow.second;
+    }
+}
+
+auto CProgram::updateShadow(GLint const location, void const * const values, std::size_t const size) -> bool
+{
+    if((location >= 0) && (static_cast<std::size_t>(location) < m_uniformShadows.size( )))
+    {
+        // GL ignores the elements past the end of an array, the shadow copy keeps the ones up to the end
+        CUniformShadow const & shadow{m_uniformShadows.at(static_cast<std::size_t>(location))};
+        std::byte* const       value{m_uniformValues.data( ) + shadow.m_offset};
+        if(size <= shadow.m_size)
+        {
+            if(0 == std::memcmp(value, values, size))
+            {
+                ++s_uniformStatistics.m_numSkipped;
+                return false;
+            }
+            std::memcpy(value, values, size);
+        }
+        else if(0 < shadow.m_size)
+        {
+            std::memcpy(value, values, shadow.m_size);
+        }
+    }
+
+    ++s_uniformStatistics.m_numIssued;
+    return true;
+}
+
+auto CProgram::reflectUniformBlocks( ) -> void
+{
+    m_uniformBlocks.clear( );
+
+    GLint numUniformBlocks{ };
+    GLint maxNameLength{ };
+    GLCheck(glGetProgramiv(m_programId, GL_ACTIVE_UNIFORM_BLOCKS, &numUniformBlocks));
+    GLCheck(glGetProgramiv(m_programId, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength));
+
+    std::string name(static_cast<std::size_t>(std::max(maxNameLength, 1)), '\0');
+    for(GLint i{ }; i < numUniformBlocks; ++i)
+    {
+        GLuint const index{static_cast<GLuint>(i)};
+
+        GLsizei length{ };
+        GLint   binding{ };
+        GLint   dataSize{ };
+        GLCheck(glGetActiveUniformBlockName(
+            m_programId, index, static_cast<GLsizei>(name.size( )), &length, name.data( )));
+        GLCheck(glGetActiveUniformBlockiv(m_programId, index, GL_UNIFORM_BLOCK_BINDING, &binding));
+        GLCheck(glGetActiveUniformBlockiv(m_programId, index, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize));
+
+        // Zero is the default binding, which can not be told apart from an explicit binding to zero
+        CUniformBlock uniformBlock{ };
+        uniformBlock.m_name     = name.substr(0, length);
+        uniformBlock.m_hash     = CUniformName{uniformBlock.m_name}.m_hash;
+        uniformBlock.m_index    = index;
+        uniformBlock.m_binding  = (0 == binding)
+            ? CUniformBlockBindings::getBinding(CUniformName{uniformBlock.m_name})
+            : CUniformBlockBindings::reserveBinding(uniformBlock.m_name, static_cast<GLuint>(binding));
+        uniformBlock.m_dataSize = dataSize;
+
+        if(uniformBlock.m_binding != static_cast<GLuint>(binding))
+        {
+            GLCheck(glUniformBlockBinding(m_programId, index, uniformBlock.m_binding));
+        }
+        m_uniformBlocks.push_back(std::move(uniformBlock));
+    }
+
+    std::sort(
+        m_uniformBlocks.begin( ),
+        m_uniformBlocks.end( ),
+        [](CUniformBlock const & lhs, CUniformBlock const & rhs) { return lhs.m_hash < rhs.m_hash; });
 }
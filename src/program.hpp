@@ -27,14 +27,30 @@
 
 #pragma once
 
+#include "shaderParser.hpp"
+#include "uniform.hpp"
+
 #include "glad/glad.h"
+#include "glm/glm.hpp"
+
+class CProgramBinaryCache;
 
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <filesystem>
+#include <vector>
 
 class CProgram
 {
+public:
+    struct CUniformStatistics
+    {
+        std::uint64_t m_numIssued{ };
+        std::uint64_t m_numSkipped{ };
+    };
+
 public:
     CProgram( );
     ~CProgram( );
@@ -46,18 +62,115 @@ public:
     CProgram& operator=(CProgram&& other);
 
 public:
-    auto create(std::filesystem::path const & shaderFilePath) -> void;
+    /// With a binary cache the linked program is restored from the cache, or stored in it after the compilation. The
+    /// defines are inserted behind the #version directive of every stage.
+    auto create(
+        std::filesystem::path const & shaderFilePath,
+        CProgramBinaryCache* const    binaryCache = nullptr,
+        std::string_view const        defines     = { }) -> void;
+    /// Links a single stage with GL_PROGRAM_SEPARABLE, to be combined with other stages in a program pipeline.
+    auto createSeparable(CShaderSource const & shaderSource, CProgramBinaryCache* const binaryCache = nullptr) -> void;
     auto destroy( ) -> void;
 
+    /// Takes ownership of a program linked elsewhere, e.g. by CProgramBatch.
+    auto adopt(GLuint const programId) -> void;
+
     auto getId( ) const -> GLuint;
 
     auto bind( ) const -> void;
     auto unbind( ) const -> void;
 
+    /// Checks whether the program can execute in the current state, e.g. with the bound vertex array. The check is
+    /// expensive and meant for debug builds.
+    auto validate( ) const -> void;
+
+    /// Active uniforms outside of the uniform blocks, sorted by the hash of their names.
+    auto getUniforms( ) const -> std::vector<CUniform> const &;
+    /// Returns nullptr if the uniform is not active in the linked program.
+    auto findUniform(CUniformName const name) const -> CUniform const *;
+    auto hasUniform(CUniformName const name) const -> bool;
+
+    /// Active uniform blocks, sorted by the hash of their names.
+    auto getUniformBlocks( ) const -> std::vector<CUniformBlock> const &;
+    /// Returns nullptr if the uniform block is not active in the linked program.
+    auto findUniformBlock(CUniformName const name) const -> CUniformBlock const *;
+
+    /// The location is a stable handle for the typed setters until the program is linked again.
+    auto getUniformLocation(CUniformName const name) const -> GLint;
+    auto getUniformLocation(std::string const & name) const -> GLint;
+
     auto setUniform(std::string const & name, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) -> void;
-    auto getUniformLocation(std::string const & name) -> GLint;
+
+    template<typename TValue>
+    auto setUniform(CUniformName const name, TValue const & value) -> void;
+    template<typename TValue>
+    auto setUniform(GLint const location, TValue const & value) -> void;
+
+    /// Sets count consecutive elements of an array uniform, starting at location. Samplers are set as GLint. The
+    /// upload is skipped if the values equal the shadow copy of the uniform, which is read back after linking.
+    auto setUniforms(GLint const location, GLfloat const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::vec2 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::vec3 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::vec4 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, GLint const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::ivec2 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::ivec3 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::ivec4 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, GLuint const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::uvec2 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::uvec3 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::uvec4 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::mat2 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::mat3 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::mat4 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::mat2x3 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::mat3x2 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::mat2x4 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::mat4x2 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::mat3x4 const * values, GLsizei const count) -> void;
+    auto setUniforms(GLint const location, glm::mat4x3 const * values, GLsizei const count) -> void;
+
+    /// Uploads of all programs since the last reset, which is meant to happen once per frame.
+    static auto getUniformStatistics( ) -> CUniformStatistics;
+    static auto resetUniformStatistics( ) -> void;
+
+private:
+    struct CUniformShadow
+    {
+        std::uint32_t m_offset{ };
+        std::uint32_t m_size{ };
+    };
+
+    auto build(
+        std::vector<CShaderSource> const & shaderSources,
+        CProgramBinaryCache* const         binaryCache,
+        bool const                         separable) -> void;
+    auto link(std::vector<CShaderSource> const & shaderSources, bool const retrievable, bool const separable) -> void;
+    auto checkStatus(GLenum const status) const -> void;
+    auto reflectUniforms( ) -> void;
+    auto addUniform(std::string name, GLenum const type, GLint const arraySize, GLint const location) -> void;
+    auto readUniformValues( ) -> void;
+    /// Binds every uniform block to the binding of its name, see CUniformBlockBindings.
+    auto reflectUniformBlocks( ) -> void;
+    /// Compares the values with the shadow copy at the location and updates it. Returns true if the upload is needed.
+    auto updateShadow(GLint const location, void const * const values, std::size_t const size) -> bool;
 
 private:
-    GLuint                                 m_programId{ };
-    std::unordered_map<std::string, GLint> m_uniformLocationCache{ };
+    GLuint                      m_programId{ };
+    std::vector<CUniform>       m_uniforms{ };
+    std::vector<CUniformShadow> m_uniformShadows{ };
+    std::vector<std::byte>      m_uniformValues{ };
+    std::vector<CUniformBlock>  m_uniformBlocks{ };
 };
+
+template<typename TValue>
+auto CProgram::setUniform(CUniformName const name, TValue const & value) -> void
+{
+    setUniforms(getUniformLocation(name), &value, 1);
+}
+
+template<typename TValue>
+auto CProgram::setUniform(GLint const location, TValue const & value) -> void
+{
+    setUniforms(location, &value, 1);
+}
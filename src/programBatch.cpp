@@ -0,0 +1,412 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "programBatch.hpp"
+#include "programBinaryCache.hpp"
+#include "deviceCaps.hpp"
+#include "shaderParser.hpp"
+#include "shaderType.hpp"
+#include "error.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+// GL_KHR_parallel_shader_compile, glad is generated without the extension. The ARB extension uses the same values.
+constexpr GLenum k_completionStatus{0x91B1};
+constexpr GLuint k_maxCompilerThreads{0xFFFFFFFF};
+
+using PFNGLMAXSHADERCOMPILERTHREADSKHRPROC = void(APIENTRYP)(GLuint count);
+
+auto compileShader(GLuint const programId, EShaderType const shaderType, std::string const & source) -> GLuint
+{
+    GLCheck(GLuint const shaderId{glCreateShader(static_cast<GLenum>(shaderType))});
+    if(0 == shaderId)
+    {
+        throw std::runtime_error("glCreateShader returned zero.");
+    }
+
+    GLchar const * const c_str{source.c_str( )};
+    GLCheck(glShaderSource(shaderId, 1, &c_str, nullptr));
+    GLCheck(glCompileShader(shaderId));
+    GLCheck(glAttachShader(programId, shaderId));
+    return shaderId;
+}
+
+auto getShaderInfoLog(GLuint const shaderId) -> std::string
+{
+    GLint logLength{ };
+    GLCheck(glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &logLength));
+
+    std::string message{ };
+    message.resize(logLength);
+    GLCheck(glGetShaderInfoLog(shaderId, logLength, &logLength, message.data( )));
+    message.resize(logLength);
+    return message;
+}
+
+auto getProgramInfoLog(GLuint const programId) -> std::string
+{
+    GLint logLength{ };
+    GLCheck(glGetProgramiv(programId, GL_INFO_LOG_LENGTH, &logLength));
+
+    std::string message{ };
+    message.resize(logLength);
+    GLCheck(glGetProgramInfoLog(programId, logLength, &logLength, message.data( )));
+    message.resize(logLength);
+    return message;
+}
+}
+
+CProgramBatch::~CProgramBatch( )
+{
+    destroy( );
+}
+
+auto CProgramBatch::create(
+    CDeviceCaps const & deviceCaps, GLADloadproc const loadProc, CProgramBinaryCache* const binaryCache) -> void
+{
+    destroy( );
+
+    m_binaryCache = binaryCache;
+    m_isParallel  = deviceCaps.hasExtension(EExtension::KhrParallelShaderCompile) ||
+                   deviceCaps.hasExtension(EExtension::ArbParallelShaderCompile);
+    if(!m_isParallel)
+    {
+        spdlog::info("Shaders are compiled without GL_KHR_parallel_shader_compile, every program blocks.");
+        return;
+    }
+
+    auto maxShaderCompilerThreads{
+        reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(loadProc("glMaxShaderCompilerThreadsKHR"))};
+    if(nullptr == maxShaderCompilerThreads)
+    {
+        maxShaderCompilerThreads =
+            reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(loadProc("glMaxShaderCompilerThreadsARB"));
+    }
+    if(nullptr != maxShaderCompilerThreads)
+    {
+        // The driver chooses the number of threads
+        GLCheck(maxShaderCompilerThreads(k_maxCompilerThreads));
+    }
+}
+
+auto CProgramBatch::destroy( ) -> void
+{
+    // The programs still pending were never adopted by a CProgram
+    for(Handle const handle : m_pending)
+    {
+        CEntry const & entry{m_entries.at(handle)};
+        for(GLuint const shaderId : entry.m_shaderIds)
+        {
+            GLCheck(glDeleteShader(shaderId));
+        }
+        GLCheck(glDeleteProgram(entry.m_programId));
+    }
+
+    m_binaryCache = { };
+    m_isParallel  = { };
+    m_fallback.destroy( );
+    m_entries.clear( );
+    m_pending.clear( );
+    m_completed.clear( );
+    m_firstSubmitTime    = { };
+    m_lastCompletionTime = { };
+}
+
+auto CProgramBatch::setFallback(CProgram&& fallback) -> void
+{
+    m_fallback = std::move(fallback);
+}
+
+auto CProgramBatch::add(std::filesystem::path const & shaderFilePath) -> Handle
+{
+    CShaderParser parser{ };
+    parser.parse(shaderFilePath);
+
+    Handle const handle{m_entries.size( )};
+    CEntry&      entry{m_entries.emplace_back( )};
+    entry.m_shaderFilePath = shaderFilePath;
+    entry.m_submitTime     = std::chrono::steady_clock::now( );
+    if(1 == m_entries.size( ))
+    {
+        m_firstSubmitTime = entry.m_submitTime;
+    }
+
+    submit(handle, parser.getShaderSources( ));
+    return handle;
+}
+
+auto CProgramBatch::reload(
+    std::filesystem::path const &               shaderFilePath,
+    std::vector<CShaderSource> const &          shaderSources,
+    std::chrono::steady_clock::time_point const changeTime) -> std::size_t
+{
+    std::size_t numReloaded{ };
+    for(Handle handle{ }; handle < m_entries.size( ); ++handle)
+    {
+        CEntry& entry{m_entries.at(handle)};
+        if(entry.m_shaderFilePath != shaderFilePath)
+        {
+            continue;
+        }
+
+        // A reload that is still compiling is superseded by the newer sources
+        if(0 != entry.m_programId)
+        {
+            for(GLuint const shaderId : std::exchange(entry.m_shaderIds, { }))
+            {
+                GLCheck(glDeleteShader(shaderId));
+            }
+            GLCheck(glDeleteProgram(std::exchange(entry.m_programId, { })));
+            m_pending.erase(std::remove(m_pending.begin( ), m_pending.end( ), handle), m_pending.end( ));
+        }
+
+        // The current program stays in use until the new one is linked
+        if(EProgramState::Ready != entry.m_state)
+        {
+            entry.m_state = EProgramState::Pending;
+        }
+        entry.m_submitTime = std::chrono::steady_clock::now( );
+        entry.m_changeTime = changeTime;
+
+        submit(handle, shaderSources);
+        ++numReloaded;
+    }
+    return numReloaded;
+}
+
+auto CProgramBatch::poll( ) -> std::vector<Handle>
+{
+    std::size_t numBlocking{ };
+    auto const  isCompleted{[this, &numBlocking](Handle const handle) {
+        CEntry& entry{m_entries.at(handle)};
+        if(m_isParallel)
+        {
+            GLint isCompletionReady{ };
+            GLCheck(glGetProgramiv(entry.m_programId, k_completionStatus, &isCompletionReady));
+            if(GL_FALSE == isCompletionReady)
+            {
+                return false;
+            }
+        }
+        else if(numBlocking++ > 0)
+        {
+            return false;
+        }
+
+        complete(entry);
+        m_completed.push_back(handle);
+        return true;
+    }};
+    m_pending.erase(std::remove_if(m_pending.begin( ), m_pending.end( ), isCompleted), m_pending.end( ));
+
+    return std::exchange(m_completed, { });
+}
+
+auto CProgramBatch::finish( ) -> std::vector<Handle>
+{
+    for(Handle const handle : m_pending)
+    {
+        complete(m_entries.at(handle));
+        m_completed.push_back(handle);
+    }
+    m_pending.clear( );
+
+    return std::exchange(m_completed, { });
+}
+
+auto CProgramBatch::getState(Handle const handle) const -> EProgramState
+{
+    return m_entries.at(handle).m_state;
+}
+
+auto CProgramBatch::getProgram(Handle const handle) -> CProgram&
+{
+    CEntry& entry{m_entries.at(handle)};
+    return (EProgramState::Ready == entry.m_state) ? entry.m_program : m_fallback;
+}
+
+auto CProgramBatch::getNumPending( ) const -> std::size_t
+{
+    return m_pending.size( );
+}
+
+auto CProgramBatch::isParallel( ) const -> bool
+{
+    return m_isParallel;
+}
+
+auto CProgramBatch::getStatistics( ) const -> CStatistics
+{
+    CStatistics statistics{ };
+    statistics.m_numPrograms = m_entries.size( );
+    for(CEntry const & entry : m_entries)
+    {
+        statistics.m_numReady  += (EProgramState::Ready == entry.m_state) ? 1 : 0;
+        statistics.m_numFailed += (EProgramState::Failed == entry.m_state) ? 1 : 0;
+    }
+    if(m_pending.empty( ) && !m_entries.empty( ))
+    {
+        statistics.m_totalTime = m_lastCompletionTime - m_firstSubmitTime;
+    }
+    return statistics;
+}
+
+auto CProgramBatch::print( ) const -> void
+{
+    CStatistics const statistics{getStatistics( )};
+    spdlog::info(
+        "Program batch: {} programs, {} ready, {} failed, {} pending, {:.1f} ms from the first submission to the last "
+        "completion.",
+        statistics.m_numPrograms, statistics.m_numReady, statistics.m_numFailed, m_pending.size( ),
+        std::chrono::duration<double, std::milli>{statistics.m_totalTime}.count( ));
+}
+
+auto CProgramBatch::submit(Handle const handle, std::vector<CShaderSource> const & shaderSources) -> void
+{
+    CEntry& entry{m_entries.at(handle)};
+
+    bool const isCacheEnabled{(nullptr != m_binaryCache) && m_binaryCache->isEnabled( )};
+    if(isCacheEnabled)
+    {
+        entry.m_key = m_binaryCache->getKey(shaderSources);
+
+        GLCheck(GLuint const programId{glCreateProgram( )});
+        if(m_binaryCache->load(programId, entry.m_key))
+        {
+            entry.m_program.adopt(programId);
+            entry.m_state        = EProgramState::Ready;
+            m_lastCompletionTime = std::chrono::steady_clock::now( );
+            m_completed.push_back(handle);
+            logReload(entry);
+            return;
+        }
+        GLCheck(glDeleteProgram(programId));
+    }
+
+    // Neither the compile nor the link status is queried, the driver works on the program until the first query
+    try
+    {
+        GLCheck(entry.m_programId = glCreateProgram( ));
+        if(0 == entry.m_programId)
+        {
+            throw std::runtime_error("glCreateProgram returned zero.");
+        }
+        for(CShaderSource const & shaderSource : shaderSources)
+        {
+            entry.m_shaderIds.push_back(
+                compileShader(entry.m_programId, shaderSource.m_shaderType, shaderSource.m_source));
+        }
+        if(isCacheEnabled)
+        {
+            GLCheck(glProgramParameteri(entry.m_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+        }
+        GLCheck(glLinkProgram(entry.m_programId));
+    }
+    catch(...)
+    {
+        for(GLuint const shaderId : std::exchange(entry.m_shaderIds, { }))
+        {
+            glDeleteShader(shaderId);
+        }
+        glDeleteProgram(std::exchange(entry.m_programId, { }));
+        if(0 == entry.m_program.getId( ))
+        {
+            entry.m_state = EProgramState::Failed;
+        }
+        throw;
+    }
+
+    m_pending.push_back(handle);
+}
+
+auto CProgramBatch::logReload(CEntry& entry) -> void
+{
+    if(std::chrono::steady_clock::time_point{ } == entry.m_changeTime)
+    {
+        return;
+    }
+
+    spdlog::info(
+        R"(Reloaded "{}" {:.1f} ms after the change.)", entry.m_shaderFilePath.string( ),
+        std::chrono::duration<double, std::milli>{m_lastCompletionTime - entry.m_changeTime}.count( ));
+    entry.m_changeTime = { };
+}
+
+auto CProgramBatch::complete(CEntry& entry) -> void
+{
+    GLint isLinked{ };
+    GLCheck(glGetProgramiv(entry.m_programId, GL_LINK_STATUS, &isLinked));
+    m_lastCompletionTime = std::chrono::steady_clock::now( );
+
+    if(GL_TRUE == isLinked)
+    {
+        for(GLuint const shaderId : entry.m_shaderIds)
+        {
+            GLCheck(glDetachShader(entry.m_programId, shaderId));
+            GLCheck(glDeleteShader(shaderId));
+        }
+        entry.m_shaderIds.clear( );
+
+        // Adopting the new program deletes the previous one of a reload
+        entry.m_program.adopt(std::exchange(entry.m_programId, { }));
+        entry.m_state = EProgramState::Ready;
+
+        if(nullptr != m_binaryCache)
+        {
+            m_binaryCache->save(entry.m_program.getId( ), entry.m_key, m_lastCompletionTime - entry.m_submitTime);
+        }
+        logReload(entry);
+        return;
+    }
+
+    // The log of the program names the failed stage only, the logs of the shaders have the details
+    std::string message{getProgramInfoLog(entry.m_programId)};
+    for(GLuint const shaderId : std::exchange(entry.m_shaderIds, { }))
+    {
+        message += getShaderInfoLog(shaderId);
+        GLCheck(glDeleteShader(shaderId));
+    }
+    GLCheck(glDeleteProgram(std::exchange(entry.m_programId, { })));
+    entry.m_changeTime = { };
+
+    // A failed reload keeps the program that was linked before
+    if(0 != entry.m_program.getId( ))
+    {
+        spdlog::error(
+            R"(The program "{}" failed, the previous one stays in use: {})", entry.m_shaderFilePath.string( ), message);
+        return;
+    }
+    entry.m_state = EProgramState::Failed;
+
+    spdlog::error(R"(The program "{}" failed: {})", entry.m_shaderFilePath.string( ), message);
+}
@@ -0,0 +1,136 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "program.hpp"
+
+#include "glad/glad.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+class CDeviceCaps;
+class CProgramBinaryCache;
+
+enum class EProgramState : std::uint8_t
+{
+    Pending = 0,
+    Ready   = 1,
+    Failed  = 2,
+};
+
+/// Compiles and links many programs without waiting for the driver between them.
+///
+/// add( ) submits the shaders and the program right away and never queries a status. With
+/// GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile the driver compiles on its own threads and poll( )
+/// checks GL_COMPLETION_STATUS_KHR without blocking. Without the extension every status query blocks, poll( ) then
+/// completes one program per call. Until its program is ready, getProgram( ) returns the fallback program. Reloaded
+/// programs are swapped in the same way, e.g. for the changes reported by CShaderWatcher.
+class CProgramBatch
+{
+public:
+    using Handle = std::size_t;
+
+    struct CStatistics
+    {
+        std::size_t              m_numPrograms{ };
+        std::size_t              m_numReady{ };
+        std::size_t              m_numFailed{ };
+        std::chrono::nanoseconds m_totalTime{ };
+    };
+
+public:
+    CProgramBatch( ) = default;
+    ~CProgramBatch( );
+
+    CProgramBatch(CProgramBatch const & other)            = delete;
+    CProgramBatch& operator=(CProgramBatch const & other) = delete;
+
+    CProgramBatch(CProgramBatch&& other)                  = delete;
+    CProgramBatch& operator=(CProgramBatch&& other)       = delete;
+
+public:
+    /// The loader resolves the entry points of the extension, which glad does not load.
+    auto create(
+        CDeviceCaps const &        deviceCaps,
+        GLADloadproc const         loadProc,
+        CProgramBinaryCache* const binaryCache = nullptr) -> void;
+    auto destroy( ) -> void;
+    auto setFallback(CProgram&& fallback) -> void;
+
+    auto add(std::filesystem::path const & shaderFilePath) -> Handle;
+    /// Compiles the new sources of every program made from the file. The current program stays in use until the new
+    /// one is linked and is kept if the link fails. Returns the number of programs reloaded.
+    auto reload(
+        std::filesystem::path const &               shaderFilePath,
+        std::vector<CShaderSource> const &          shaderSources,
+        std::chrono::steady_clock::time_point const changeTime) -> std::size_t;
+
+    /// Handles of the programs completed since the last poll.
+    auto poll( ) -> std::vector<Handle>;
+    /// Blocks until every program is completed.
+    auto finish( ) -> std::vector<Handle>;
+
+    auto getState(Handle const handle) const -> EProgramState;
+    auto getProgram(Handle const handle) -> CProgram&;
+    auto getNumPending( ) const -> std::size_t;
+    auto isParallel( ) const -> bool;
+
+    auto getStatistics( ) const -> CStatistics;
+    auto print( ) const -> void;
+
+private:
+    struct CEntry
+    {
+        std::filesystem::path                 m_shaderFilePath{ };
+        EProgramState                         m_state{EProgramState::Pending};
+        GLuint                                m_programId{ };
+        std::vector<GLuint>                   m_shaderIds{ };
+        std::uint64_t                         m_key{ };
+        std::chrono::steady_clock::time_point m_submitTime{ };
+        std::chrono::steady_clock::time_point m_changeTime{ };
+        CProgram                              m_program{ };
+    };
+
+    auto submit(Handle const handle, std::vector<CShaderSource> const & shaderSources) -> void;
+    auto logReload(CEntry& entry) -> void;
+    auto complete(CEntry& entry) -> void;
+
+private:
+    CProgramBinaryCache*                  m_binaryCache{ };
+    bool                                  m_isParallel{ };
+    CProgram                              m_fallback{ };
+    std::vector<CEntry>                   m_entries{ };
+    std::vector<Handle>                   m_pending{ };
+    std::vector<Handle>                   m_completed{ };
+    std::chrono::steady_clock::time_point m_firstSubmitTime{ };
+    std::chrono::steady_clock::time_point m_lastCompletionTime{ };
+};
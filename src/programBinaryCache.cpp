@@ -0,0 +1,236 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "programBinaryCache.hpp"
+#include "deviceCaps.hpp"
+#include "error.hpp"
+#include "hash.hpp"
+
+#include "fmt/core.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+constexpr std::array<char, 8> k_fileMagic{'L', 'O', 'G', 'L', 'P', 'B', '0', '1'};
+
+struct CFileHeader
+{
+    std::array<char, 8> m_magic{ };
+    std::uint32_t       m_format{ };
+    std::uint32_t       m_length{ };
+};
+}
+
+auto CProgramBinaryCache::create(CDeviceCaps const & deviceCaps, std::filesystem::path const & cacheDirectory) -> void
+{
+    *this = { };
+
+    bool const isLoaded{(nullptr != glad_glGetProgramBinary) && (nullptr != glad_glProgramBinary)};
+    if(cacheDirectory.empty( ) || !isLoaded || !deviceCaps.isVersion(4, 1) ||
+       (deviceCaps.getInteger(GL_NUM_PROGRAM_BINARY_FORMATS) <= 0))
+    {
+        spdlog::info("The program binary cache is disabled.");
+        return;
+    }
+
+    m_cacheDirectory = cacheDirectory;
+    m_deviceKey = fnv1a(deviceCaps.getVersion( ), fnv1a(deviceCaps.getRenderer( ), fnv1a(deviceCaps.getVendor( ))));
+    m_isEnabled = true;
+
+    GLint numFormats{ };
+    GLCheck(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats));
+    m_formats.resize(static_cast<std::size_t>(numFormats));
+    GLCheck(glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, m_formats.data( )));
+}
+
+auto CProgramBinaryCache::isEnabled( ) const -> bool
+{
+    return m_isEnabled;
+}
+
+auto CProgramBinaryCache::getKey(std::vector<CShaderSource> const & shaderSources) const -> std::uint64_t
+{
+    std::uint64_t key{m_deviceKey};
+    for(CShaderSource const & shaderSource : shaderSources)
+    {
+        // The length separates the sources, moving text from one source to the next changes the key
+        key = fnv1a(shaderSource.m_shaderType, key);
+        key = fnv1a(shaderSource.m_source, fnv1a(shaderSource.m_source.size( ), key));
+    }
+    return key;
+}
+
+auto CProgramBinaryCache::load(GLuint const programId, std::uint64_t const key) -> bool
+{
+    if(!m_isEnabled)
+    {
+        return false;
+    }
+
+    auto const                  start{std::chrono::steady_clock::now( )};
+    std::filesystem::path const filePath{getFilePath(key)};
+
+    CFileHeader       header{ };
+    std::vector<char> binary{ };
+    bool              isTruncated{ };
+    {
+        std::ifstream file{filePath, std::ios::binary};
+        if(file.read(reinterpret_cast<char*>(&header), sizeof(header)) && (k_fileMagic == header.m_magic))
+        {
+            // The length comes from the file, it is checked against the file size before anything is allocated
+            std::error_code      errorCode{ };
+            std::uintmax_t const fileSize{std::filesystem::file_size(filePath, errorCode)};
+            isTruncated = errorCode || (fileSize != (sizeof(header) + std::uintmax_t{header.m_length}));
+            if(!isTruncated)
+            {
+                binary.resize(header.m_length);
+                file.read(binary.data( ), static_cast<std::streamsize>(binary.size( )));
+            }
+        }
+        if(!isTruncated && (!file || binary.empty( )))
+        {
+            ++m_statistics.m_numMisses;
+            return false;
+        }
+    }
+    if(isTruncated)
+    {
+        spdlog::debug(R"(The length of the program binary "{}" does not match its file.)", filePath.string( ));
+        ++m_statistics.m_numMisses;
+
+        std::error_code errorCode{ };
+        std::filesystem::remove(filePath, errorCode);
+        return false;
+    }
+
+    // A format unknown to the driver would raise an error instead of a failed link
+    GLenum const format{static_cast<GLenum>(header.m_format)};
+    bool const   isFormat{
+        m_formats.end( ) != std::find(m_formats.begin( ), m_formats.end( ), static_cast<GLint>(format))};
+
+    GLint isLinked{GL_FALSE};
+    if(isFormat)
+    {
+        GLCheck(glProgramBinary(programId, format, binary.data( ), static_cast<GLsizei>(binary.size( ))));
+        GLCheck(glGetProgramiv(programId, GL_LINK_STATUS, &isLinked));
+    }
+    if(GL_TRUE != isLinked)
+    {
+        spdlog::debug(R"(The driver rejected the program binary "{}".)", filePath.string( ));
+        ++m_statistics.m_numRejected;
+        ++m_statistics.m_numMisses;
+
+        std::error_code errorCode{ };
+        std::filesystem::remove(filePath, errorCode);
+        return false;
+    }
+
+    ++m_statistics.m_numHits;
+    m_statistics.m_loadTime += std::chrono::steady_clock::now( ) - start;
+    return true;
+}
+
+auto CProgramBinaryCache::save(
+    GLuint const programId, std::uint64_t const key, std::chrono::nanoseconds const compileTime) -> void
+{
+    if(!m_isEnabled)
+    {
+        return;
+    }
+    m_statistics.m_compileTime += compileTime;
+
+    GLint length{ };
+    GLCheck(glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &length));
+    if(length <= 0)
+    {
+        spdlog::warn("The driver provides no binary of the program {}.", programId);
+        return;
+    }
+
+    std::vector<char> binary(static_cast<std::size_t>(length));
+    GLenum            format{ };
+    GLCheck(glGetProgramBinary(programId, length, &length, &format, binary.data( )));
+
+    CFileHeader const header{k_fileMagic, static_cast<std::uint32_t>(format), static_cast<std::uint32_t>(length)};
+
+    // The binary is written to a temporary file first and renamed, readers never see a partial file.
+    std::filesystem::path const filePath{getFilePath(key)};
+    std::filesystem::path const temporaryFilePath{filePath.string( ) + ".tmp"};
+    std::error_code             errorCode{ };
+
+    std::filesystem::create_directories(m_cacheDirectory, errorCode);
+    {
+        std::ofstream file{temporaryFilePath, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        file.write(binary.data( ), length);
+        if(!file.flush( ))
+        {
+            spdlog::warn(R"(The program binary "{}" can not be written.)", filePath.string( ));
+            return;
+        }
+    }
+
+    std::filesystem::rename(temporaryFilePath, filePath, errorCode);
+    if(errorCode)
+    {
+        spdlog::warn(R"(The program binary "{}" can not be written: {})", filePath.string( ), errorCode.message( ));
+        std::filesystem::remove(temporaryFilePath, errorCode);
+    }
+}
+
+auto CProgramBinaryCache::getStatistics( ) const -> CStatistics
+{
+    return m_statistics;
+}
+
+auto CProgramBinaryCache::print( ) const -> void
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    Milliseconds const loadTime{m_statistics.m_loadTime};
+    Milliseconds const compileTime{m_statistics.m_compileTime};
+    Milliseconds const averageCompileTime{
+        (0 == m_statistics.m_numMisses) ? Milliseconds{ }
+                                        : (compileTime / static_cast<double>(m_statistics.m_numMisses))};
+    Milliseconds const savedTime{(averageCompileTime * static_cast<double>(m_statistics.m_numHits)) - loadTime};
+
+    spdlog::info(
+        "Program binaries: {} hits in {:.1f} ms, {} misses in {:.1f} ms, {} rejected, about {:.1f} ms saved.",
+        m_statistics.m_numHits, loadTime.count( ), m_statistics.m_numMisses, compileTime.count( ),
+        m_statistics.m_numRejected, savedTime.count( ));
+}
+
+auto CProgramBinaryCache::getFilePath(std::uint64_t const key) const -> std::filesystem::path
+{
+    return m_cacheDirectory / fmt::format("program-{:016x}.bin", key);
+}
@@ -0,0 +1,84 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "shaderParser.hpp"
+
+#include "glad/glad.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+class CDeviceCaps;
+
+/// Linked programs on disk, stored with glGetProgramBinary and restored with glProgramBinary.
+///
+/// The key of a program hashes its shader sources together with the vendor, renderer and version strings, a driver
+/// update therefore never sees the binaries of an older driver. A binary rejected by the driver counts as a miss and
+/// the program is compiled as usual. Every file is written to a temporary file first and renamed.
+class CProgramBinaryCache
+{
+public:
+    struct CStatistics
+    {
+        std::uint64_t            m_numHits{ };
+        std::uint64_t            m_numMisses{ };
+        std::uint64_t            m_numRejected{ };
+        std::chrono::nanoseconds m_loadTime{ };
+        std::chrono::nanoseconds m_compileTime{ };
+    };
+
+public:
+    /// Without support for program binaries on the device the cache stays disabled and never hits.
+    auto create(CDeviceCaps const & deviceCaps, std::filesystem::path const & cacheDirectory) -> void;
+
+    auto isEnabled( ) const -> bool;
+    /// Key of the program made of the shader sources.
+    auto getKey(std::vector<CShaderSource> const & shaderSources) const -> std::uint64_t;
+
+    /// Restores the binary of the key into the program, false if there is none or the driver rejects it.
+    auto load(GLuint const programId, std::uint64_t const key) -> bool;
+    /// Stores the binary of the linked program, the program has to be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT.
+    auto save(GLuint const programId, std::uint64_t const key, std::chrono::nanoseconds const compileTime) -> void;
+
+    auto getStatistics( ) const -> CStatistics;
+    /// Logs the hits and misses and the time saved by the hits, estimated with the average time of the misses.
+    auto print( ) const -> void;
+
+private:
+    auto getFilePath(std::uint64_t const key) const -> std::filesystem::path;
+
+private:
+    std::filesystem::path m_cacheDirectory{ };
+    std::uint64_t         m_deviceKey{ };
+    std::vector<GLint>    m_formats{ };
+    bool                  m_isEnabled{ };
+    CStatistics           m_statistics{ };
+};
@@ -0,0 +1,240 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "programPipelineCache.hpp"
+#include "deviceCaps.hpp"
+#include "error.hpp"
+#include "hash.hpp"
+#include "stateAccess.hpp"
+#include "stateCache.hpp"
+
+#include "fmt/core.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+auto getStageBit(EShaderType const shaderType) -> GLbitfield
+{
+    switch(shaderType)
+    {
+    case EShaderType::Vertex:         return GL_VERTEX_SHADER_BIT;
+    case EShaderType::Fragment:       return GL_FRAGMENT_SHADER_BIT;
+    case EShaderType::Geometry:       return GL_GEOMETRY_SHADER_BIT;
+    case EShaderType::TessControl:    return GL_TESS_CONTROL_SHADER_BIT;
+    case EShaderType::TessEvaluation: return GL_TESS_EVALUATION_SHADER_BIT;
+    case EShaderType::Compute:        return GL_COMPUTE_SHADER_BIT;
+    }
+    throw std::invalid_argument("Unknown shader type.");
+}
+}
+
+CProgramPipelineCache::~CProgramPipelineCache( )
+{
+    destroy( );
+}
+
+auto CProgramPipelineCache::create(CDeviceCaps const & deviceCaps, CProgramBinaryCache* const binaryCache) -> void
+{
+    destroy( );
+
+    if(!deviceCaps.isVersion(4, 1) && !deviceCaps.hasExtension(EExtension::ArbSeparateShaderObjects))
+    {
+        throw std::runtime_error("Program pipelines require OpenGL 4.1 or GL_ARB_separate_shader_objects.");
+    }
+    m_binaryCache = binaryCache;
+}
+
+auto CProgramPipelineCache::destroy( ) -> void
+{
+    for(auto const & entry : m_pipelines)
+    {
+        GLuint const pipeline{std::get<1>(entry)};
+        GLCheck(glDeleteProgramPipelines(1, &pipeline));
+        CStateCache::get( ).forgetProgramPipeline(pipeline);
+    }
+
+    m_binaryCache = { };
+    m_stages.clear( );
+    m_pipelines.clear( );
+    m_statistics = { };
+}
+
+auto CProgramPipelineCache::addStage(CShaderSource const & shaderSource) -> Stage
+{
+    Stage const stage{fnv1a(shaderSource.m_source, fnv1a(shaderSource.m_shaderType, k_fnv1aOffsetBasis))};
+    auto const [iterator, isInserted]{m_stages.try_emplace(stage)};
+    CStageEntry& entry{iterator->second};
+
+    if(!isInserted)
+    {
+        if((entry.m_shaderType != shaderSource.m_shaderType) || (entry.m_source != shaderSource.m_source))
+        {
+            throw std::runtime_error(fmt::format("Two shader stages share the hash {:016x}.", stage));
+        }
+        ++m_statistics.m_numStageHits;
+        return stage;
+    }
+
+    ++m_statistics.m_numStageMisses;
+    try
+    {
+        entry.m_shaderType = shaderSource.m_shaderType;
+        entry.m_source     = shaderSource.m_source;
+        entry.m_program.createSeparable(shaderSource, m_binaryCache);
+    }
+    catch(...)
+    {
+        m_stages.erase(iterator);
+        throw;
+    }
+    return stage;
+}
+
+auto CProgramPipelineCache::addStages(std::filesystem::path const & shaderFilePath, std::string_view const defines)
+    -> std::vector<Stage>
+{
+    CShaderParser parser{ };
+    parser.parse(shaderFilePath, defines);
+
+    std::vector<Stage> stages{ };
+    for(CShaderSource const & shaderSource : parser.getShaderSources( ))
+    {
+        stages.push_back(addStage(shaderSource));
+    }
+    return stages;
+}
+
+auto CProgramPipelineCache::getStageProgram(Stage const stage) -> CProgram&
+{
+    auto const iter{m_stages.find(stage)};
+    if(iter == m_stages.end( ))
+    {
+        throw std::out_of_range(fmt::format("The shader stage {:016x} was never added.", stage));
+    }
+    return iter->second.m_program;
+}
+
+auto CProgramPipelineCache::getPipeline(std::vector<Stage> const & stages) -> GLuint
+{
+    std::vector<Stage> sortedStages{stages};
+    std::sort(sortedStages.begin( ), sortedStages.end( ));
+
+    std::uint64_t key{k_fnv1aOffsetBasis};
+    for(Stage const stage : sortedStages)
+    {
+        key = fnv1a(stage, key);
+    }
+
+    auto const iter{m_pipelines.find(key)};
+    if(iter != m_pipelines.end( ))
+    {
+        ++m_statistics.m_numPipelineHits;
+        return iter->second;
+    }
+    ++m_statistics.m_numPipelineMisses;
+
+    GLbitfield stageBits{ };
+    for(Stage const stage : sortedStages)
+    {
+        GLbitfield const stageBit{getStageBit(m_stages.at(stage).m_shaderType)};
+        if(0 != (stageBits & stageBit))
+        {
+            throw std::invalid_argument("A program pipeline can not combine two stages of the same shader type.");
+        }
+        stageBits |= stageBit;
+    }
+
+    GLuint pipeline{ };
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glCreateProgramPipelines(1, &pipeline));
+    }
+    else
+    {
+        GLCheck(glGenProgramPipelines(1, &pipeline));
+    }
+
+    for(Stage const stage : sortedStages)
+    {
+        CStageEntry const & entry{m_stages.at(stage)};
+        GLCheck(glUseProgramStages(pipeline, getStageBit(entry.m_shaderType), entry.m_program.getId( )));
+    }
+
+    m_pipelines.emplace(key, pipeline);
+    return pipeline;
+}
+
+auto CProgramPipelineCache::bind(GLuint const pipeline) const -> void
+{
+    CStateCache::get( ).bindProgramPipeline(pipeline);
+}
+
+auto CProgramPipelineCache::validate(GLuint const pipeline) const -> void
+{
+    GLCheck(glValidateProgramPipeline(pipeline));
+
+    GLint result{ };
+    GLCheck(glGetProgramPipelineiv(pipeline, GL_VALIDATE_STATUS, &result));
+    if(result != GL_TRUE)
+    {
+        GLint logLength{ };
+        GLCheck(glGetProgramPipelineiv(pipeline, GL_INFO_LOG_LENGTH, &logLength));
+
+        std::string message{ };
+        message.resize(logLength);
+        GLCheck(glGetProgramPipelineInfoLog(pipeline, logLength, &logLength, message.data( )));
+
+        throw std::runtime_error(message);
+    }
+}
+
+auto CProgramPipelineCache::getNumStages( ) const -> std::size_t
+{
+    return m_stages.size( );
+}
+
+auto CProgramPipelineCache::getNumPipelines( ) const -> std::size_t
+{
+    return m_pipelines.size( );
+}
+
+auto CProgramPipelineCache::getStatistics( ) const -> CStatistics
+{
+    return m_statistics;
+}
+
+auto CProgramPipelineCache::print( ) const -> void
+{
+    spdlog::info(
+        "Program pipelines: {} stages linked, {} stage hits, {} pipelines created, {} pipeline hits.",
+        m_statistics.m_numStageMisses, m_statistics.m_numStageHits, m_statistics.m_numPipelineMisses,
+        m_statistics.m_numPipelineHits);
+}
@@ -0,0 +1,112 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "program.hpp"
+#include "shaderParser.hpp"
+#include "shaderType.hpp"
+
+#include "glad/glad.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class CDeviceCaps;
+class CProgramBinaryCache;
+
+/// Separable programs of single shader stages and the program pipelines that combine them.
+///
+/// Every distinct stage source is linked once with GL_PROGRAM_SEPARABLE, and every combination of stages gets a
+/// pipeline object on its first request. V vertex and F fragment stages take V + F links instead of the V x F links of
+/// complete programs; combining stages in a pipeline links nothing. The uniforms are set on the stage programs.
+class CProgramPipelineCache
+{
+public:
+    /// Hash of the type and source of a stage.
+    using Stage = std::uint64_t;
+
+    struct CStatistics
+    {
+        std::uint64_t m_numStageHits{ };
+        std::uint64_t m_numStageMisses{ };
+        std::uint64_t m_numPipelineHits{ };
+        std::uint64_t m_numPipelineMisses{ };
+    };
+
+public:
+    CProgramPipelineCache( ) = default;
+    ~CProgramPipelineCache( );
+
+    CProgramPipelineCache(CProgramPipelineCache const & other)            = delete;
+    CProgramPipelineCache& operator=(CProgramPipelineCache const & other) = delete;
+
+    CProgramPipelineCache(CProgramPipelineCache&& other)                  = delete;
+    CProgramPipelineCache& operator=(CProgramPipelineCache&& other)       = delete;
+
+public:
+    auto create(CDeviceCaps const & deviceCaps, CProgramBinaryCache* const binaryCache = nullptr) -> void;
+    auto destroy( ) -> void;
+
+    /// Links the stage on the first request of its source.
+    auto addStage(CShaderSource const & shaderSource) -> Stage;
+    /// Adds every stage of the file, in the order of the file.
+    auto addStages(std::filesystem::path const & shaderFilePath, std::string_view const defines = { })
+        -> std::vector<Stage>;
+    auto getStageProgram(Stage const stage) -> CProgram&;
+
+    /// Pipeline of the stages, created on the first request of the combination. The order of the stages is irrelevant,
+    /// each shader type may occur once.
+    auto getPipeline(std::vector<Stage> const & stages) -> GLuint;
+    auto bind(GLuint const pipeline) const -> void;
+    /// Checks whether the pipeline can execute in the current state. The check is expensive and meant for debug builds.
+    auto validate(GLuint const pipeline) const -> void;
+
+    auto getNumStages( ) const -> std::size_t;
+    auto getNumPipelines( ) const -> std::size_t;
+    auto getStatistics( ) const -> CStatistics;
+    auto print( ) const -> void;
+
+private:
+    struct CStageEntry
+    {
+        EShaderType m_shaderType{ };
+        std::string m_source{ };
+        CProgram    m_program{ };
+    };
+
+private:
+    CProgramBinaryCache*                      m_binaryCache{ };
+    std::unordered_map<Stage, CStageEntry>    m_stages{ };
+    std::unordered_map<std::uint64_t, GLuint> m_pipelines{ };
+    CStatistics                               m_statistics{ };
+};
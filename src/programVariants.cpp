@@ -0,0 +1,229 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "programVariants.hpp"
+#include "hash.hpp"
+
+#include "fmt/core.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+constexpr std::uint32_t k_maskBits{64};
+constexpr std::size_t   k_minNumSlots{16};
+
+auto getHash(std::size_t const handle, std::uint64_t const mask) -> std::size_t
+{
+    return static_cast<std::size_t>(fnv1a(mask, fnv1a(handle, k_fnv1aOffsetBasis)));
+}
+
+auto getNumBits(std::size_t const numValues) -> std::uint32_t
+{
+    std::uint32_t numBits{1};
+    while((std::size_t{1} << numBits) < numValues)
+    {
+        ++numBits;
+    }
+    return numBits;
+}
+}
+
+auto CProgramVariants::CKey::operator==(CKey const & other) const -> bool
+{
+    return (m_handle == other.m_handle) && (m_mask == other.m_mask);
+}
+
+auto CProgramVariants::create(CProgramBinaryCache* const binaryCache) -> void
+{
+    destroy( );
+    m_binaryCache = binaryCache;
+}
+
+auto CProgramVariants::destroy( ) -> void
+{
+    m_slots.clear( );
+    m_programs.clear( );
+    m_shaderFiles.clear( );
+    m_binaryCache = { };
+}
+
+auto CProgramVariants::addShader(
+    std::filesystem::path const & shaderFilePath, std::vector<CShaderFeature> const & features) -> Handle
+{
+    CShaderFile shaderFile{ };
+    shaderFile.m_shaderFilePath = shaderFilePath;
+
+    std::uint32_t shift{ };
+    for(CShaderFeature const & feature : features)
+    {
+        std::uint32_t const numBits{feature.m_values.empty( ) ? 1 : getNumBits(feature.m_values.size( ))};
+        if((shift + numBits) > k_maskBits)
+        {
+            throw std::runtime_error(fmt::format(
+                R"(The features of "{}" exceed the {} bits of a mask.)", shaderFilePath.string( ), k_maskBits));
+        }
+
+        shaderFile.m_features.push_back({feature.m_name, feature.m_values, shift, numBits});
+        shaderFile.m_validBits |= ((Mask{1} << numBits) - 1) << shift;
+        shift                  += numBits;
+    }
+
+    m_shaderFiles.push_back(std::move(shaderFile));
+    return m_shaderFiles.size( ) - 1;
+}
+
+auto CProgramVariants::getMask(Handle const handle, std::string_view const feature, std::size_t const value) const
+    -> Mask
+{
+    CFeature const & shaderFeature{getFeature(m_shaderFiles.at(handle), feature)};
+    std::size_t const numValues{shaderFeature.m_values.empty( ) ? 2 : shaderFeature.m_values.size( )};
+    if(value >= numValues)
+    {
+        throw std::out_of_range(fmt::format(R"(The feature "{}" has no value {}.)", feature, value));
+    }
+    return static_cast<Mask>(value) << shaderFeature.m_shift;
+}
+
+auto CProgramVariants::getDefines(Handle const handle, Mask const mask) const -> std::string
+{
+    CShaderFile const & shaderFile{m_shaderFiles.at(handle)};
+    if(0 != (mask & ~shaderFile.m_validBits))
+    {
+        throw std::out_of_range(fmt::format(
+            R"(The mask {:#x} sets bits without a feature of "{}".)", mask, shaderFile.m_shaderFilePath.string( )));
+    }
+
+    std::string defines{ };
+    for(CFeature const & feature : shaderFile.m_features)
+    {
+        Mask const value{(mask >> feature.m_shift) & ((Mask{1} << feature.m_numBits) - 1)};
+        if(!feature.m_values.empty( ) && (value >= feature.m_values.size( )))
+        {
+            throw std::out_of_range(fmt::format(R"(The feature "{}" has no value {}.)", feature.m_name, value));
+        }
+
+        if(feature.m_values.empty( ))
+        {
+            if(0 != value)
+            {
+                defines += fmt::format("#define {} 1\n", feature.m_name);
+            }
+            continue;
+        }
+
+        defines += fmt::format("#define {} {}\n", feature.m_name, value);
+        for(std::size_t i{ }; i < feature.m_values.size( ); ++i)
+        {
+            defines += fmt::format("#define {}_{} {}\n", feature.m_name, feature.m_values.at(i), i);
+        }
+    }
+    return defines;
+}
+
+auto CProgramVariants::getProgram(Handle const handle, Mask const mask) -> CProgram&
+{
+    CKey const key{handle, mask};
+    if(!m_slots.empty( ))
+    {
+        CSlot const & slot{m_slots[findSlot(key)]};
+        if(nullptr != slot.m_program)
+        {
+            return *slot.m_program;
+        }
+    }
+
+    std::filesystem::path const & shaderFilePath{m_shaderFiles.at(handle).m_shaderFilePath};
+    spdlog::debug(R"(Compiling the variant {:#x} of "{}".)", mask, shaderFilePath.string( ));
+
+    CProgram program{ };
+    program.create(shaderFilePath, m_binaryCache, getDefines(handle, mask));
+
+    if((2 * (m_programs.size( ) + 1)) > m_slots.size( ))
+    {
+        growSlots( );
+    }
+    CProgram& newProgram{m_programs.emplace_back(std::move(program))};
+    m_slots[findSlot(key)] = {key, &newProgram};
+    return newProgram;
+}
+
+auto CProgramVariants::precompile(Handle const handle, std::vector<Mask> const & masks) -> void
+{
+    for(Mask const mask : masks)
+    {
+        getProgram(handle, mask);
+    }
+}
+
+auto CProgramVariants::getNumPrograms( ) const -> std::size_t
+{
+    return m_programs.size( );
+}
+
+auto CProgramVariants::getFeature(CShaderFile const & shaderFile, std::string_view const name) const
+    -> CFeature const &
+{
+    auto const iter{std::find_if(
+        shaderFile.m_features.begin( ), shaderFile.m_features.end( ),
+        [name](CFeature const & feature) { return feature.m_name == name; })};
+    if(iter == shaderFile.m_features.end( ))
+    {
+        throw std::out_of_range(
+            fmt::format(R"(The shader "{}" has no feature "{}".)", shaderFile.m_shaderFilePath.string( ), name));
+    }
+    return *iter;
+}
+
+auto CProgramVariants::findSlot(CKey const & key) const -> std::size_t
+{
+    std::size_t const indexMask{m_slots.size( ) - 1};
+    for(std::size_t index{getHash(key.m_handle, key.m_mask) & indexMask};; index = (index + 1) & indexMask)
+    {
+        CSlot const & slot{m_slots[index]};
+        if((nullptr == slot.m_program) || (slot.m_key == key))
+        {
+            return index;
+        }
+    }
+}
+
+auto CProgramVariants::growSlots( ) -> void
+{
+    std::vector<CSlot> slots(std::max(k_minNumSlots, 2 * m_slots.size( )));
+    std::swap(slots, m_slots);
+    for(CSlot const & slot : slots)
+    {
+        if(nullptr != slot.m_program)
+        {
+            m_slots[findSlot(slot.m_key)] = slot;
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "program.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CProgramBinaryCache;
+
+/// Switch of a shader file. Without values the feature is boolean, otherwise it selects one of the values.
+struct CShaderFeature
+{
+    std::string              m_name{ };
+    std::vector<std::string> m_values{ };
+};
+
+/// Variants of shader files, selected by a bitmask of their features and compiled on first use.
+///
+/// The features of a file occupy consecutive bits of the mask in the order of their declaration, one bit for a boolean
+/// feature and as many bits as the values need for the others. A variant defines "<name>" as 1 only for its set
+/// boolean features, for #ifdef. An enumerated feature always defines "<name>" as the index of its value and
+/// "<name>_<value>" with the index of each value for comparisons.
+class CProgramVariants
+{
+public:
+    using Handle = std::size_t;
+    using Mask   = std::uint64_t;
+
+public:
+    auto create(CProgramBinaryCache* const binaryCache = nullptr) -> void;
+    auto destroy( ) -> void;
+
+    auto addShader(std::filesystem::path const & shaderFilePath, std::vector<CShaderFeature> const & features)
+        -> Handle;
+
+    /// Bits of the feature set to the value, the masks of several features are combined with |.
+    auto getMask(Handle const handle, std::string_view const feature, std::size_t const value = 1) const -> Mask;
+    auto getDefines(Handle const handle, Mask const mask) const -> std::string;
+
+    /// Program of the variant, compiled on the first request.
+    auto getProgram(Handle const handle, Mask const mask) -> CProgram&;
+    /// Compiles the listed variants ahead of their first use, e.g. at startup.
+    auto precompile(Handle const handle, std::vector<Mask> const & masks) -> void;
+
+    auto getNumPrograms( ) const -> std::size_t;
+
+private:
+    struct CFeature
+    {
+        std::string              m_name{ };
+        std::vector<std::string> m_values{ };
+        std::uint32_t            m_shift{ };
+        std::uint32_t            m_numBits{ };
+    };
+
+    struct CShaderFile
+    {
+        std::filesystem::path m_shaderFilePath{ };
+        std::vector<CFeature> m_features{ };
+        Mask                  m_validBits{ };
+    };
+
+    struct CKey
+    {
+        Handle m_handle{ };
+        Mask   m_mask{ };
+
+        auto operator==(CKey const & other) const -> bool;
+    };
+
+    /// Entry of the open addressing table of the programs, empty without a program.
+    struct CSlot
+    {
+        CKey      m_key{ };
+        CProgram* m_program{ };
+    };
+
+    auto getFeature(CShaderFile const & shaderFile, std::string_view const name) const -> CFeature const &;
+    /// Slot of the key, or the empty slot that ends its probe sequence.
+    auto findSlot(CKey const & key) const -> std::size_t;
+    auto growSlots( ) -> void;
+
+private:
+    CProgramBinaryCache*     m_binaryCache{ };
+    std::vector<CShaderFile> m_shaderFiles{ };
+    /// Linear probing over a power of two number of slots, at most half of them used.
+    std::vector<CSlot> m_slots{ };
+    /// The programs keep their addresses while the slots grow.
+    std::deque<CProgram> m_programs{ };
+};
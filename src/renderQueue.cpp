@@ -0,0 +1,230 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "renderQueue.hpp"
+#include "error.hpp"
+#include "stateCache.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace
+{
+constexpr std::size_t k_numDigits{sizeof(std::uint64_t)};
+constexpr std::size_t k_numBuckets{256};
+
+auto setCapability(GLenum const capability, bool const isEnabled) -> void
+{
+    if(isEnabled)
+    {
+        GLCheck(glEnable(capability));
+    }
+    else
+    {
+        GLCheck(glDisable(capability));
+    }
+}
+
+// The fixed index of GL_PRIMITIVE_RESTART_FIXED_INDEX, which is not available before OpenGL 4.3
+auto getRestartIndex(GLenum const indexType) -> GLuint
+{
+    return (GL_UNSIGNED_BYTE == indexType)    ? std::numeric_limits<GLubyte>::max( )
+           : (GL_UNSIGNED_SHORT == indexType) ? std::numeric_limits<GLushort>::max( )
+                                              : std::numeric_limits<GLuint>::max( );
+}
+}
+
+auto CRenderQueue::create(std::size_t const capacity) -> void
+{
+    destroy( );
+
+    m_packets.create(capacity);
+    m_entries.reserve(capacity / sizeof(CDrawPacket));
+    m_sortBuffer.reserve(m_entries.capacity( ));
+}
+
+auto CRenderQueue::destroy( ) -> void
+{
+    m_packets.destroy( );
+    m_entries.clear( );
+    m_sortBuffer.clear( );
+    m_statistics = { };
+}
+
+auto CRenderQueue::submit(std::uint64_t const key, CDrawPacket const & packet) -> void
+{
+    m_entries.push_back(CEntry{key, m_packets.create<CDrawPacket>(packet)});
+}
+
+auto CRenderQueue::flush( ) -> void
+{
+    m_statistics              = { };
+    m_statistics.m_numPackets = m_entries.size( );
+    countStateChanges(m_statistics.m_numProgramChangesUnsorted, m_statistics.m_numVertexArrayChangesUnsorted);
+
+    sort( );
+    countStateChanges(m_statistics.m_numProgramChangesSorted, m_statistics.m_numVertexArrayChangesSorted);
+
+    execute( );
+
+    m_entries.clear( );
+    m_packets.reset( );
+}
+
+auto CRenderQueue::getNumPackets( ) const -> std::size_t
+{
+    return m_entries.size( );
+}
+
+auto CRenderQueue::getStatistics( ) const -> CStatistics
+{
+    return m_statistics;
+}
+
+auto CRenderQueue::print( ) const -> void
+{
+    spdlog::info(
+        "Render queue: {} packets, {} sort passes, program changes {} -> {}, vertex array changes {} -> {}, {} of {} "
+        "bytes at the peak.",
+        m_statistics.m_numPackets, m_statistics.m_numSortPasses, m_statistics.m_numProgramChangesUnsorted,
+        m_statistics.m_numProgramChangesSorted, m_statistics.m_numVertexArrayChangesUnsorted,
+        m_statistics.m_numVertexArrayChangesSorted, m_packets.getPeakSize( ), m_packets.getCapacity( ));
+}
+
+auto CRenderQueue::sort( ) -> void
+{
+    if(m_entries.size( ) < 2)
+    {
+        return;
+    }
+
+    // One pass over the keys counts the digits of every position
+    std::array<std::array<std::size_t, k_numBuckets>, k_numDigits> histograms{ };
+    for(CEntry const & entry : m_entries)
+    {
+        for(std::size_t digit{ }; digit < k_numDigits; ++digit)
+        {
+            ++histograms[digit][(entry.m_key >> (digit * 8)) & 0xFF];
+        }
+    }
+
+    m_sortBuffer.resize(m_entries.size( ));
+    for(std::size_t digit{ }; digit < k_numDigits; ++digit)
+    {
+        std::array<std::size_t, k_numBuckets>& histogram{histograms[digit]};
+
+        // All keys in one bucket leave the order as it is
+        std::size_t const firstKeyBucket{(m_entries.front( ).m_key >> (digit * 8)) & 0xFF};
+        if(histogram[firstKeyBucket] == m_entries.size( ))
+        {
+            continue;
+        }
+
+        std::size_t offset{ };
+        for(std::size_t& count : histogram)
+        {
+            offset = std::exchange(count, offset) + offset;
+        }
+        for(CEntry const & entry : m_entries)
+        {
+            m_sortBuffer[histogram[(entry.m_key >> (digit * 8)) & 0xFF]++] = entry;
+        }
+        m_entries.swap(m_sortBuffer);
+        ++m_statistics.m_numSortPasses;
+    }
+}
+
+auto CRenderQueue::countStateChanges(std::size_t& numProgramChanges, std::size_t& numVertexArrayChanges) const
+    -> void
+{
+    GLuint program{ };
+    GLuint vertexArray{ };
+    for(std::size_t i{ }; i < m_entries.size( ); ++i)
+    {
+        CDrawPacket const & packet{*m_entries[i].m_packet};
+        numProgramChanges     += ((0 == i) || (packet.m_program != program)) ? 1 : 0;
+        numVertexArrayChanges += ((0 == i) || (packet.m_vertexArray != vertexArray)) ? 1 : 0;
+        program                = packet.m_program;
+        vertexArray            = packet.m_vertexArray;
+    }
+}
+
+auto CRenderQueue::execute( ) -> void
+{
+    CStateCache&  stateCache{CStateCache::get( )};
+    std::uint32_t states{ };
+    GLuint        restartIndex{ };
+    for(std::size_t i{ }; i < m_entries.size( ); ++i)
+    {
+        CDrawPacket const & packet{*m_entries[i].m_packet};
+
+        // The state cache skips the program and vertex array binds that would not change anything
+        stateCache.useProgram(packet.m_program);
+        stateCache.bindVertexArray(packet.m_vertexArray);
+
+        std::uint32_t const changedStates{(0 == i) ? ~std::uint32_t{ } : (states ^ packet.m_states)};
+        if(0 != (changedStates & CDrawPacket::k_depthTest))
+        {
+            setCapability(GL_DEPTH_TEST, 0 != (packet.m_states & CDrawPacket::k_depthTest));
+        }
+        if(0 != (changedStates & CDrawPacket::k_blend))
+        {
+            setCapability(GL_BLEND, 0 != (packet.m_states & CDrawPacket::k_blend));
+        }
+        if(0 != (changedStates & CDrawPacket::k_primitiveRestart))
+        {
+            setCapability(GL_PRIMITIVE_RESTART, 0 != (packet.m_states & CDrawPacket::k_primitiveRestart));
+        }
+        states = packet.m_states;
+
+        // The restart index follows the index type of the packet, as the fixed index would
+        if((0 != (packet.m_states & CDrawPacket::k_primitiveRestart)) && (0 != packet.m_indexType) &&
+           (getRestartIndex(packet.m_indexType) != restartIndex))
+        {
+            restartIndex = getRestartIndex(packet.m_indexType);
+            GLCheck(glPrimitiveRestartIndex(restartIndex));
+        }
+
+        if(0 != packet.m_uniforms.m_bufferId)
+        {
+            CUniformBufferRing::bind(packet.m_uniformBinding, packet.m_uniforms);
+        }
+
+        if(0 == packet.m_indexType)
+        {
+            GLCheck(glDrawArrays(packet.m_mode, packet.m_first, packet.m_count));
+        }
+        else
+        {
+            void const * const indices{reinterpret_cast<void const *>(packet.m_indexOffset)};
+            GLCheck(glDrawElements(packet.m_mode, packet.m_count, packet.m_indexType, indices));
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "linearAllocator.hpp"
+#include "uniformBufferRing.hpp"
+
+#include "glad/glad.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Draw call with the state it needs, recorded by CRenderQueue and executed when the queue is flushed.
+struct CDrawPacket
+{
+    static constexpr std::uint32_t k_depthTest{1U << 0};
+    static constexpr std::uint32_t k_blend{1U << 1};
+    /// The largest value of m_indexType restarts the primitive, for index buffers created with primitive restart.
+    static constexpr std::uint32_t k_primitiveRestart{1U << 2};
+
+    GLuint              m_program{ };
+    GLuint              m_vertexArray{ };
+    GLenum              m_mode{GL_TRIANGLES};
+    /// Draws the vertices from m_first without indices if zero.
+    GLenum              m_indexType{ };
+    GLint               m_first{ };
+    GLsizei             m_count{ };
+    /// Byte offset of the first index in the element array buffer of the vertex array.
+    GLintptr            m_indexOffset{ };
+    GLuint              m_uniformBinding{ };
+    /// Bound to m_uniformBinding unless the buffer is zero.
+    CUniformBufferSlice m_uniforms{ };
+    std::uint32_t       m_states{ };
+};
+
+/// Collects the draws of a frame and executes them sorted by their keys, so draws with the same program and vertex
+/// array follow each other.
+///
+/// The packets are copied into a linear allocator that is reset by every flush. The 64-bit keys are sorted with a
+/// least significant digit radix sort of 8-bit digits; digits that are equal in all keys are skipped.
+class CRenderQueue
+{
+public:
+    /// Initial size of the packet storage, about 14k packets. A frame with more packets grows it, see CLinearAllocator.
+    static constexpr std::size_t k_defaultCapacity{1024 * 1024};
+
+    struct CStatistics
+    {
+        std::size_t m_numPackets{ };
+        std::size_t m_numSortPasses{ };
+        /// State changes of the draws in the order of their submission.
+        std::size_t m_numProgramChangesUnsorted{ };
+        std::size_t m_numVertexArrayChangesUnsorted{ };
+        /// State changes of the draws in the order of their keys, the ones issued.
+        std::size_t m_numProgramChangesSorted{ };
+        std::size_t m_numVertexArrayChangesSorted{ };
+    };
+
+public:
+    CRenderQueue( ) = default;
+    ~CRenderQueue( ) = default;
+
+    CRenderQueue(CRenderQueue const & other)            = delete;
+    CRenderQueue& operator=(CRenderQueue const & other) = delete;
+
+    CRenderQueue(CRenderQueue&& other)                  = default;
+    CRenderQueue& operator=(CRenderQueue&& other)       = default;
+
+public:
+    /// Packs a key from the most significant field to the least significant one: the layer, the lower 16 bits of the
+    /// program and vertex array names, and 24 bits of depth or submission order. Equal name bits of different objects
+    /// only weaken the grouping, the packets keep the complete names.
+    static constexpr auto makeKey(
+        std::uint8_t const  layer,
+        GLuint const        program,
+        GLuint const        vertexArray,
+        std::uint32_t const depth) -> std::uint64_t
+    {
+        return (std::uint64_t{layer} << 56) | (std::uint64_t{program & 0xFFFF} << 40) |
+               (std::uint64_t{vertexArray & 0xFFFF} << 24) | std::uint64_t{depth & 0xFF'FFFF};
+    }
+
+public:
+    auto create(std::size_t const capacity = k_defaultCapacity) -> void;
+    auto destroy( ) -> void;
+
+    auto submit(std::uint64_t const key, CDrawPacket const & packet) -> void;
+    /// Sorts and executes the packets submitted since the last flush.
+    auto flush( ) -> void;
+
+    auto getNumPackets( ) const -> std::size_t;
+    /// Statistics of the last flush.
+    auto getStatistics( ) const -> CStatistics;
+    auto print( ) const -> void;
+
+private:
+    struct CEntry
+    {
+        std::uint64_t      m_key{ };
+        CDrawPacket const* m_packet{ };
+    };
+
+    auto sort( ) -> void;
+    auto countStateChanges(std::size_t& numProgramChanges, std::size_t& numVertexArrayChanges) const -> void;
+    auto execute( ) -> void;
+
+private:
+    CLinearAllocator    m_packets{ };
+    std::vector<CEntry> m_entries{ };
+    std::vector<CEntry> m_sortBuffer{ };
+    CStatistics         m_statistics{ };
+};
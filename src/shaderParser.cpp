@@ -26,58 +26,316 @@
 /// ----------------------------------------------------------------------------
 
 #include "shaderParser.hpp"
+#include "mappedFile.hpp"
 
-#include <cstdint>
+#include "fmt/core.h"
+
+#include <algorithm>
 #include <array>
 #include <fstream>
-#include <sstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+struct CShaderStage
+{
+    std::string_view m_name{ };
+    EShaderType      m_shaderType{ };
+};
+
+constexpr std::array k_shaderStages{
+    // clang-format off
+    CShaderStage{"vertex",          EShaderType::Vertex},
+    CShaderStage{"fragment",        EShaderType::Fragment},
+    CShaderStage{"geometry",        EShaderType::Geometry},
+    CShaderStage{"tess_control",    EShaderType::TessControl},
+    CShaderStage{"tess_evaluation", EShaderType::TessEvaluation},
+    CShaderStage{"compute",         EShaderType::Compute},
+    // clang-format on
+};
+
+constexpr std::string_view k_stageMarker{"// shader "};
+constexpr std::string_view k_include{"#include"};
+constexpr std::string_view k_version{"#version"};
+constexpr std::size_t      k_maxIncludeDepth{32};
 
-auto CShaderParser::parse(std::filesystem::path const & shaderFilePath) -> void
+std::mutex                                                    s_includeFilesMutex{ };
+std::unordered_map<std::string, std::shared_ptr<std::string>> s_includeFiles{ };
+
+auto trim(std::string_view text) -> std::string_view
 {
-    enum class EShaderType : std::uint8_t
+    constexpr std::string_view k_whitespace{" \t\r\n"};
+
+    std::size_t const first{text.find_first_not_of(k_whitespace)};
+    if(std::string_view::npos == first)
     {
-        Vertex   = 0,
-        Fragment = 1,
-    };
+        return { };
+    }
+    return text.substr(first, text.find_last_not_of(k_whitespace) - first + 1);
+}
+
+auto startsWith(std::string_view const text, std::string_view const prefix) -> bool
+{
+    return text.substr(0, prefix.size( )) == prefix;
+}
+
+// Comments may precede the #version directive, a #line directive may not
+auto isComment(std::string_view const line) -> bool
+{
+    return startsWith(line, "//") || startsWith(line, "/*") || startsWith(line, "*");
+}
 
-    std::ifstream                    shaderFile(shaderFilePath);
-    std::string                      line{ };
-    EShaderType                      shaderType{ };
-    std::array<std::stringstream, 2> shaderTexts{ };
+// Include files are shared by many shaders, each file is read once per process. The contents are copied, a mapping
+// would fault once an editor truncates the file and it would change along with the file.
+auto getIncludeFile(std::filesystem::path const & filePath) -> std::shared_ptr<std::string const>
+{
+    std::string const key{std::filesystem::weakly_canonical(filePath).string( )};
 
-    while(std::getline(shaderFile, line))
+    std::lock_guard<std::mutex> const lock{s_includeFilesMutex};
+    std::shared_ptr<std::string>&     includeFile{s_includeFiles[key]};
+    if(nullptr == includeFile)
     {
-        if(std::string::npos != line.find("// shader vertex"))
+        std::ifstream file{filePath, std::ios::binary};
+        if(!file)
         {
-            shaderType = EShaderType::Vertex;
-            continue;
+            s_includeFiles.erase(key);
+            throw std::runtime_error(fmt::format(R"(The file "{}" can not be opened.)", filePath.string( )));
+        }
+        includeFile = std::make_shared<std::string>(
+            std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{ });
+    }
+    return includeFile;
+}
+}
+
+auto CShaderParser::parse(std::filesystem::path const & shaderFilePath, std::string_view const defines) -> void
+{
+    m_shaderFilePath = shaderFilePath;
+    m_shaderSources.clear( );
+    m_sourceFilePaths.assign(1, shaderFilePath);
+    m_defines           = defines;
+    m_isProloguePending = false;
+
+    CMappedFile shaderFile{ };
+    shaderFile.create(shaderFilePath);
+    scan(shaderFile.getView( ), 0, 0);
+
+    if(m_shaderSources.empty( ))
+    {
+        throw std::runtime_error(fmt::format(R"(The shader file "{}" has no stage.)", shaderFilePath.string( )));
+    }
+}
+
+auto CShaderParser::getShaderFilePath( ) const -> std::filesystem::path const &
+{
+    return m_shaderFilePath;
+}
+
+auto CShaderParser::getShaderSources( ) const -> std::vector<CShaderSource> const &
+{
+    return m_shaderSources;
+}
+
+auto CShaderParser::getShaderSource(EShaderType const shaderType) const -> std::string const &
+{
+    static std::string const s_empty{ };
+
+    auto const iter{std::find_if(
+        m_shaderSources.begin( ), m_shaderSources.end( ),
+        [shaderType](CShaderSource const & shaderSource) { return shaderSource.m_shaderType == shaderType; })};
+    return (iter == m_shaderSources.end( )) ? s_empty : iter->m_source;
+}
+
+auto CShaderParser::getVertexShaderSource( ) const -> std::string const &
+{
+    return getShaderSource(EShaderType::Vertex);
+}
+
+auto CShaderParser::getFragmentShaderSource( ) const -> std::string const &
+{
+    return getShaderSource(EShaderType::Fragment);
+}
+
+auto CShaderParser::getSourceFilePaths( ) const -> std::vector<std::filesystem::path> const &
+{
+    return m_sourceFilePaths;
+}
+
+auto CShaderParser::clearIncludeCache( ) -> void
+{
+    std::lock_guard<std::mutex> const lock{s_includeFilesMutex};
+    s_includeFiles.clear( );
+}
+
+auto CShaderParser::scan(std::string_view const text, std::size_t const fileIndex, std::size_t const depth) -> void
+{
+    // The lines between the special lines are appended as one slice
+    std::size_t sliceBegin{ };
+    auto const  appendSlice{[this, text, &sliceBegin](std::size_t const sliceEnd) {
+        if(!m_shaderSources.empty( ) && (sliceEnd > sliceBegin))
+        {
+            m_shaderSources.back( ).m_source.append(text.substr(sliceBegin, sliceEnd - sliceBegin));
         }
-        if(std::string::npos != line.find("// shader fragment"))
+        sliceBegin = sliceEnd;
+    }};
+
+    std::size_t lineNumber{ };
+    std::size_t lineBegin{ };
+    while(lineBegin < text.size( ))
+    {
+        ++lineNumber;
+        std::size_t const newline{text.find('\n', lineBegin)};
+        std::size_t const lineEnd{(std::string_view::npos == newline) ? text.size( ) : (newline + 1)};
+
+        // Only directives and comments are special, and any line that ends a pending prologue
+        std::size_t const first{text.find_first_not_of(" \t", lineBegin)};
+        bool const        isSpecial{
+            (first < lineEnd) && (('#' == text[first]) || ('/' == text[first]) || m_isProloguePending)};
+        if(!isSpecial && !m_shaderSources.empty( ))
         {
-            shaderType = EShaderType::Fragment;
+            lineBegin = lineEnd;
             continue;
         }
+        std::string_view const line{trim(text.substr(lineBegin, lineEnd - lineBegin))};
+
+        if((0 == depth) && startsWith(line, k_stageMarker))
+        {
+            appendSlice(lineBegin);
+            std::string_view const name{trim(line.substr(k_stageMarker.size( )))};
+
+            auto const stage{
+                std::find_if(k_shaderStages.begin( ), k_shaderStages.end( ), [name](auto const & candidate) {
+                    return candidate.m_name == name;
+                })};
+            if(stage == k_shaderStages.end( ))
+            {
+                throw std::runtime_error(fmt::format(
+                    R"({}({}): The shader stage "{}" is unknown.)", m_shaderFilePath.string( ), lineNumber, name));
+            }
+            bool const isRepeated{std::any_of(
+                m_shaderSources.begin( ), m_shaderSources.end( ), [stage](CShaderSource const & shaderSource) {
+                    return shaderSource.m_shaderType == stage->m_shaderType;
+                })};
+            if(isRepeated)
+            {
+                throw std::runtime_error(fmt::format(
+                    R"({}({}): The shader stage "{}" is repeated.)", m_shaderFilePath.string( ), lineNumber, name));
+            }
+
+            m_shaderSources.push_back({stage->m_shaderType, { }});
+            m_shaderSources.back( ).m_source.reserve(text.size( ) - lineEnd + m_defines.size( ));
+            m_isProloguePending = true;
+            sliceBegin          = lineEnd;
+        }
+        else if(m_shaderSources.empty( ))
+        {
+            sliceBegin = lineEnd;
+        }
+        else if(startsWith(line, k_include))
+        {
+            appendSlice(lineBegin);
+            appendPrologue( );
+            include(line, fileIndex, lineNumber, depth);
+            appendLineDirective(lineNumber + 1, fileIndex);
+            sliceBegin = lineEnd;
+        }
+        else if(startsWith(line, k_version))
+        {
+            appendSlice(lineEnd);
+            appendPrologue( );
+            appendLineDirective(lineNumber + 1, fileIndex);
+        }
+        else if(m_isProloguePending && !line.empty( ) && !isComment(line))
+        {
+            appendSlice(lineBegin);
+            appendPrologue( );
+            appendLineDirective(lineNumber, fileIndex);
+        }
+
+        lineBegin = lineEnd;
+    }
+    appendSlice(text.size( ));
+}
+
+auto CShaderParser::include(
+    std::string_view const line, std::size_t const fileIndex, std::size_t const lineNumber, std::size_t const depth)
+    -> void
+{
+    std::filesystem::path const & filePath{m_sourceFilePaths.at(fileIndex)};
+
+    std::string_view const argument{trim(line.substr(k_include.size( )))};
+    bool const             isQuoted{
+        (argument.size( ) > 2) && (((argument.front( ) == '"') && (argument.back( ) == '"')) ||
+                                   ((argument.front( ) == '<') && (argument.back( ) == '>')))};
+    if(!isQuoted)
+    {
+        throw std::runtime_error(
+            fmt::format(R"({}({}): The include "{}" is malformed.)", filePath.string( ), lineNumber, line));
+    }
+    if(depth >= k_maxIncludeDepth)
+    {
+        throw std::runtime_error(fmt::format(
+            "{}({}): The includes are nested too deeply, probably a file includes itself.", filePath.string( ),
+            lineNumber));
+    }
 
-        std::stringstream& shaderText = shaderTexts.at(static_cast<size_t>(shaderType));
-        shaderText << line << '\n';
+    std::filesystem::path const includeFilePath{
+        filePath.parent_path( ) / std::string{argument.substr(1, argument.size( ) - 2)}};
+
+    std::shared_ptr<std::string const> includeFile{ };
+    try
+    {
+        includeFile = getIncludeFile(includeFilePath);
+    }
+    catch(std::exception const & e)
+    {
+        throw std::runtime_error(fmt::format("{}({}): {}", filePath.string( ), lineNumber, e.what( )));
     }
 
-    m_shaderFilePath       = shaderFilePath;
-    m_vertexShaderSource   = shaderTexts.at(static_cast<size_t>(EShaderType::Vertex)).str( );
-    m_fragmentShaderSource = shaderTexts.at(static_cast<size_t>(EShaderType::Fragment)).str( );
+    std::size_t const includeFileIndex{getSourceFileIndex(includeFilePath)};
+    appendLineDirective(1, includeFileIndex);
+    scan(*includeFile, includeFileIndex, depth + 1);
 }
 
-auto CShaderParser::getShaderFilePath( ) const -> std::filesystem::path
+auto CShaderParser::appendPrologue( ) -> void
 {
-    return m_shaderFilePath;
+    if(!m_isProloguePending)
+    {
+        return;
+    }
+    m_isProloguePending = false;
+
+    std::string& source{m_shaderSources.back( ).m_source};
+    if(!source.empty( ) && (source.back( ) != '\n'))
+    {
+        source += '\n';
+    }
+    source += m_defines;
 }
 
-auto CShaderParser::getVertexShaderSource( ) const -> std::string
+auto CShaderParser::appendLineDirective(std::size_t const lineNumber, std::size_t const fileIndex) -> void
 {
-    return m_vertexShaderSource;
+    std::string& source{m_shaderSources.back( ).m_source};
+    if(!source.empty( ) && (source.back( ) != '\n'))
+    {
+        source += '\n';
+    }
+    source += fmt::format("#line {} {}\n", lineNumber, fileIndex);
 }
 
-auto CShaderParser::getFragmentShaderSource( ) const -> std::string
+auto CShaderParser::getSourceFileIndex(std::filesystem::path const & filePath) -> std::size_t
 {
-    return m_fragmentShaderSource;
+    auto const iter{std::find(m_sourceFilePaths.begin( ), m_sourceFilePaths.end( ), filePath)};
+    if(iter != m_sourceFilePaths.end( ))
+    {
+        return static_cast<std::size_t>(iter - m_sourceFilePaths.begin( ));
+    }
+
+    m_sourceFilePaths.push_back(filePath);
+    return m_sourceFilePaths.size( ) - 1;
 }
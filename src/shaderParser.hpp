@@ -27,20 +27,59 @@
 
 #pragma once
 
-#include <string>
+#include "shaderType.hpp"
+
+#include <cstddef>
 #include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct CShaderSource
+{
+    EShaderType m_shaderType{ };
+    std::string m_source{ };
+};
 
+/// Splits a .shader file into the sources of its stages.
+///
+/// A stage starts with a "// shader <stage>" line, the stages are vertex, fragment, geometry, tess_control,
+/// tess_evaluation and compute. Lines in front of the first stage are ignored. The file is mapped and scanned once,
+/// the sources are assembled from slices of the mapping. An #include "file" line, relative to the including file, is
+/// replaced by the file, which is copied into memory once per process. #line directives keep the line numbers of the
+/// compiler messages correct, the source string number is the index of the file in getSourceFilePaths( ). The defines,
+/// one complete line each, are inserted into every stage right behind the #version directive.
 class CShaderParser
 {
 public:
-    auto parse(std::filesystem::path const & shaderFilePath) -> void;
+    auto parse(std::filesystem::path const & shaderFilePath, std::string_view const defines = { }) -> void;
+
+    auto getShaderFilePath( ) const -> std::filesystem::path const &;
+    auto getShaderSources( ) const -> std::vector<CShaderSource> const &;
+    /// Source of the stage, empty if the file has no such stage.
+    auto getShaderSource(EShaderType const shaderType) const -> std::string const &;
+    auto getVertexShaderSource( ) const -> std::string const &;
+    auto getFragmentShaderSource( ) const -> std::string const &;
+    auto getSourceFilePaths( ) const -> std::vector<std::filesystem::path> const &;
 
-    auto getShaderFilePath( ) const -> std::filesystem::path;
-    auto getVertexShaderSource( ) const -> std::string;
-    auto getFragmentShaderSource( ) const -> std::string;
+    /// Forgets the include files read so far, e.g. after they changed on disk.
+    static auto clearIncludeCache( ) -> void;
+
+private:
+    auto scan(std::string_view const text, std::size_t const fileIndex, std::size_t const depth) -> void;
+    auto include(
+        std::string_view const line,
+        std::size_t const      fileIndex,
+        std::size_t const      lineNumber,
+        std::size_t const      depth) -> void;
+    auto appendPrologue( ) -> void;
+    auto appendLineDirective(std::size_t const lineNumber, std::size_t const fileIndex) -> void;
+    auto getSourceFileIndex(std::filesystem::path const & filePath) -> std::size_t;
 
 private:
-    std::filesystem::path m_shaderFilePath{ };
-    std::string           m_vertexShaderSource{ };
-    std::string           m_fragmentShaderSource{ };
-};
\ No newline at end of file
+    std::filesystem::path              m_shaderFilePath{ };
+    std::vector<CShaderSource>         m_shaderSources{ };
+    std::vector<std::filesystem::path> m_sourceFilePaths{ };
+    std::string                        m_defines{ };
+    bool                               m_isProloguePending{ };
+};
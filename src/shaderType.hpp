@@ -31,6 +31,10 @@
 
 enum class EShaderType : GLenum
 {
-    Vertex = GL_VERTEX_SHADER,
-    Fragment = GL_FRAGMENT_SHADER
+    Vertex         = GL_VERTEX_SHADER,
+    Fragment       = GL_FRAGMENT_SHADER,
+    Geometry       = GL_GEOMETRY_SHADER,
+    TessControl    = GL_TESS_CONTROL_SHADER,
+    TessEvaluation = GL_TESS_EVALUATION_SHADER,
+    Compute        = GL_COMPUTE_SHADER,
 };
@@ -0,0 +1,302 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "shaderWatcher.hpp"
+
+#include "spdlog/spdlog.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+// The watcher thread checks for new requests and expired debounce times at this interval
+constexpr std::chrono::milliseconds k_pollInterval{20};
+
+struct CPendingChange
+{
+    std::filesystem::path                 m_shaderFilePath{ };
+    std::chrono::steady_clock::time_point m_firstEventTime{ };
+    std::chrono::steady_clock::time_point m_lastEventTime{ };
+};
+
+/// Files of the watched shaders and the directories watched for them, owned by the watcher thread.
+struct CWatchedFiles
+{
+    std::unordered_map<int, std::filesystem::path>                      m_directories{ };
+    std::unordered_map<std::string, std::vector<std::filesystem::path>> m_shaders{ };
+};
+
+auto getKey(std::filesystem::path const & filePath) -> std::string
+{
+    return std::filesystem::absolute(filePath).lexically_normal( ).string( );
+}
+
+#ifdef __linux__
+// Saving in place closes the file, saving through a temporary file moves or creates it
+constexpr std::uint32_t k_watchedEvents{IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE};
+
+/// Parses the shader and watches the files it consists of. Returns false if the shader can not be parsed.
+auto parse(int const inotify, CWatchedFiles& watchedFiles, CShaderChange& change) -> bool
+{
+    CShaderParser parser{ };
+    try
+    {
+        parser.parse(change.m_shaderFilePath);
+    }
+    catch(std::exception const & e)
+    {
+        spdlog::error(R"(The shader "{}" can not be parsed: {})", change.m_shaderFilePath.string( ), e.what( ));
+        return false;
+    }
+
+    // The includes may have changed, the files of the shader are registered again
+    for(auto& [filePath, shaderFilePaths] : watchedFiles.m_shaders)
+    {
+        shaderFilePaths.erase(
+            std::remove(shaderFilePaths.begin( ), shaderFilePaths.end( ), change.m_shaderFilePath),
+            shaderFilePaths.end( ));
+    }
+
+    for(std::filesystem::path const & sourceFilePath : parser.getSourceFilePaths( ))
+    {
+        std::filesystem::path const directory{std::filesystem::absolute(sourceFilePath).parent_path( )};
+        int const                   watch{inotify_add_watch(inotify, directory.c_str( ), k_watchedEvents)};
+        if(-1 == watch)
+        {
+            spdlog::warn(R"(The directory "{}" can not be watched.)", directory.string( ));
+            continue;
+        }
+        watchedFiles.m_directories.insert_or_assign(watch, directory);
+        watchedFiles.m_shaders[getKey(sourceFilePath)].push_back(change.m_shaderFilePath);
+    }
+
+    change.m_shaderSources = parser.getShaderSources( );
+    return true;
+}
+
+/// Reads the available events and marks the shaders of the changed files as pending.
+auto readEvents(int const inotify, CWatchedFiles const & watchedFiles, std::vector<CPendingChange>& pending) -> void
+{
+    alignas(inotify_event) std::array<char, 4096> buffer{ };
+    auto const                                     now{std::chrono::steady_clock::now( )};
+
+    ssize_t length{ };
+    while((length = read(inotify, buffer.data( ), buffer.size( ))) > 0)
+    {
+        for(char const * event{buffer.data( )}; event < buffer.data( ) + length;)
+        {
+            inotify_event const & header{*reinterpret_cast<inotify_event const *>(event)};
+            event += sizeof(inotify_event) + header.len;
+
+            auto const directory{watchedFiles.m_directories.find(header.wd)};
+            if((0 == header.len) || (directory == watchedFiles.m_directories.end( )))
+            {
+                continue;
+            }
+
+            auto const shaders{watchedFiles.m_shaders.find(getKey(std::get<1>(*directory) / header.name))};
+            if(shaders == watchedFiles.m_shaders.end( ))
+            {
+                continue;
+            }
+
+            for(std::filesystem::path const & shaderFilePath : std::get<1>(*shaders))
+            {
+                auto const iter{std::find_if(pending.begin( ), pending.end( ), [&](CPendingChange const & change) {
+                    return change.m_shaderFilePath == shaderFilePath;
+                })};
+                if(iter == pending.end( ))
+                {
+                    pending.push_back(CPendingChange{shaderFilePath, now, now});
+                }
+                else
+                {
+                    iter->m_lastEventTime = now;
+                }
+            }
+        }
+    }
+}
+#endif
+}
+
+CShaderWatcher::~CShaderWatcher( )
+{
+    destroy( );
+}
+
+auto CShaderWatcher::create(std::chrono::milliseconds const debounceTime) -> void
+{
+    destroy( );
+
+#ifdef __linux__
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(-1 == m_inotify)
+    {
+        throw std::runtime_error("Failed to create the inotify instance of the shader watcher.");
+    }
+
+    m_debounceTime = debounceTime;
+    m_thread       = std::thread{&CShaderWatcher::run, this};
+#else
+    static_cast<void>(debounceTime);
+    spdlog::info("Shader files are not watched on this platform.");
+#endif
+}
+
+auto CShaderWatcher::destroy( ) -> void
+{
+    if(!isEnabled( ))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        m_isStopping = true;
+    }
+    m_thread.join( );
+
+#ifdef __linux__
+    close(m_inotify);
+#endif
+    m_inotify      = -1;
+    m_debounceTime = { };
+    m_watchRequests.clear( );
+    m_changes.clear( );
+    m_isStopping = false;
+}
+
+auto CShaderWatcher::isEnabled( ) const -> bool
+{
+    return -1 != m_inotify;
+}
+
+auto CShaderWatcher::watch(std::filesystem::path const & shaderFilePath) -> void
+{
+    if(!isEnabled( ))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> const lock{m_mutex};
+    m_watchRequests.push_back(shaderFilePath);
+}
+
+auto CShaderWatcher::poll( ) -> std::vector<CShaderChange>
+{
+    if(!isEnabled( ))
+    {
+        return { };
+    }
+
+    std::lock_guard<std::mutex> const lock{m_mutex};
+    return std::exchange(m_changes, { });
+}
+
+auto CShaderWatcher::run( ) -> void
+{
+#ifdef __linux__
+    CWatchedFiles                      watchedFiles{ };
+    std::vector<CPendingChange>        pending{ };
+    std::vector<std::filesystem::path> watchRequests{ };
+    std::vector<CShaderChange>         changes{ };
+
+    try
+    {
+        while(true)
+        {
+            {
+                std::lock_guard<std::mutex> const lock{m_mutex};
+                if(m_isStopping)
+                {
+                    break;
+                }
+                watchRequests = std::exchange(m_watchRequests, { });
+            }
+
+            for(std::filesystem::path& shaderFilePath : watchRequests)
+            {
+                CShaderChange change{std::move(shaderFilePath)};
+                parse(m_inotify, watchedFiles, change);
+            }
+
+            pollfd descriptor{m_inotify, POLLIN, 0};
+            if(::poll(&descriptor, 1, static_cast<int>(k_pollInterval.count( ))) > 0)
+            {
+                readEvents(m_inotify, watchedFiles, pending);
+            }
+
+            // A burst of events, e.g. of an editor saving through a temporary file, is parsed once it is over
+            auto const now{std::chrono::steady_clock::now( )};
+            auto const isQuiet{[this, now](CPendingChange const & change) {
+                return (now - change.m_lastEventTime) >= m_debounceTime;
+            }};
+            auto const quiet{std::stable_partition(pending.begin( ), pending.end( ), std::not_fn(isQuiet))};
+            if(quiet != pending.end( ))
+            {
+                // The includes are cached per process and have to be read again
+                CShaderParser::clearIncludeCache( );
+            }
+            for(auto iter{quiet}; iter != pending.end( ); ++iter)
+            {
+                CShaderChange change{iter->m_shaderFilePath, { }, iter->m_firstEventTime};
+                if(parse(m_inotify, watchedFiles, change))
+                {
+                    changes.push_back(std::move(change));
+                }
+            }
+            pending.erase(quiet, pending.end( ));
+
+            if(!changes.empty( ))
+            {
+                std::lock_guard<std::mutex> const lock{m_mutex};
+                std::move(changes.begin( ), changes.end( ), std::back_inserter(m_changes));
+                changes.clear( );
+            }
+        }
+    }
+    catch(std::exception const & e)
+    {
+        spdlog::error("The shader watcher thread stopped: {}", e.what( ));
+    }
+#endif
+}
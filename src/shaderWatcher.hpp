@@ -0,0 +1,89 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "shaderParser.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Sources of a shader file that changed on disk, parsed by the watcher thread.
+struct CShaderChange
+{
+    std::filesystem::path                 m_shaderFilePath{ };
+    std::vector<CShaderSource>            m_shaderSources{ };
+    /// Time of the first file event of the change, the start of the reload latency.
+    std::chrono::steady_clock::time_point m_changeTime{ };
+};
+
+/// Watches shader files and their includes for changes on a thread of its own, on Linux through inotify.
+///
+/// The directories of the files are watched, so editors that save to a temporary file and rename it are seen as
+/// well. The events of a file are debounced until none arrived for the debounce time, then the shader is parsed again
+/// and handed to the render thread by poll( ). On other platforms the watcher stays disabled.
+class CShaderWatcher
+{
+public:
+    static constexpr std::chrono::milliseconds k_defaultDebounceTime{100};
+
+public:
+    CShaderWatcher( ) = default;
+    ~CShaderWatcher( );
+
+    CShaderWatcher(CShaderWatcher const & other)            = delete;
+    CShaderWatcher& operator=(CShaderWatcher const & other) = delete;
+
+    CShaderWatcher(CShaderWatcher&& other)                  = delete;
+    CShaderWatcher& operator=(CShaderWatcher&& other)       = delete;
+
+public:
+    auto create(std::chrono::milliseconds const debounceTime = k_defaultDebounceTime) -> void;
+    auto destroy( ) -> void;
+    auto isEnabled( ) const -> bool;
+
+    /// Watches the shader file and the files it includes. The path is reported back unchanged by poll( ).
+    auto watch(std::filesystem::path const & shaderFilePath) -> void;
+
+    /// Shaders that changed and were parsed successfully since the last poll, never blocks.
+    auto poll( ) -> std::vector<CShaderChange>;
+
+private:
+    auto run( ) -> void;
+
+private:
+    std::chrono::milliseconds          m_debounceTime{ };
+    int                                m_inotify{-1};
+    std::thread                        m_thread{ };
+    std::mutex                         m_mutex{ };
+    std::vector<std::filesystem::path> m_watchRequests{ };
+    std::vector<CShaderChange>         m_changes{ };
+    bool                               m_isStopping{ };
+};
@@ -0,0 +1,52 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+// Instruction sets enabled for the compilation target. The code paths are selected at compile time, a CPU without
+// the instruction sets the target was compiled for is not supported.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define LEARNOGL_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define LEARNOGL_SIMD_SSE41
+#include <smmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define LEARNOGL_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+// Every CPU with AVX2 supports F16C, MSVC has no separate switch for it
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define LEARNOGL_SIMD_F16C
+#include <immintrin.h>
+#endif
@@ -0,0 +1,86 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "stateAccess.hpp"
+#include "deviceCaps.hpp"
+
+#include "glad/glad.h"
+#include "spdlog/spdlog.h"
+
+namespace
+{
+EStateAccess s_stateAccess{EStateAccess::BindToEdit};
+bool         s_isVertexAttribBinding{ };
+
+auto isDirectStateAccessLoaded( ) -> bool
+{
+    // glad loads the entry points of the core versions only, the extension alone is not sufficient.
+    return (nullptr != glad_glCreateBuffers) && (nullptr != glad_glNamedBufferStorage) &&
+           (nullptr != glad_glCreateVertexArrays) && (nullptr != glad_glEnableVertexArrayAttrib) &&
+           (nullptr != glad_glVertexArrayVertexBuffer) && (nullptr != glad_glVertexArrayAttribFormat) &&
+           (nullptr != glad_glVertexArrayAttribBinding) && (nullptr != glad_glVertexArrayElementBuffer);
+}
+
+auto isVertexAttribBindingLoaded( ) -> bool
+{
+    return (nullptr != glad_glVertexAttribFormat) && (nullptr != glad_glVertexAttribIFormat) &&
+           (nullptr != glad_glVertexAttribBinding) && (nullptr != glad_glBindVertexBuffer);
+}
+}
+
+auto CStateAccess::select(CDeviceCaps const & deviceCaps, bool const allowDirect) -> EStateAccess
+{
+    bool const isCore{deviceCaps.isVersion(4, 5)};
+    bool const isExtension{deviceCaps.hasExtension(EExtension::ArbDirectStateAccess)};
+
+    s_stateAccess = (allowDirect && (isCore || isExtension) && isDirectStateAccessLoaded( )) ? EStateAccess::Direct
+                                                                                             : EStateAccess::BindToEdit;
+    s_isVertexAttribBinding =
+        (deviceCaps.isVersion(4, 3) || deviceCaps.hasExtension(EExtension::ArbVertexAttribBinding)) &&
+        isVertexAttribBindingLoaded( );
+
+    spdlog::info(
+        "OpenGL {}.{}: {} state access, {} vertex formats.", deviceCaps.getMajorVersion( ),
+        deviceCaps.getMinorVersion( ), (EStateAccess::Direct == s_stateAccess) ? "direct" : "bind-to-edit",
+        s_isVertexAttribBinding ? "separate" : "pointer");
+    return s_stateAccess;
+}
+
+auto CStateAccess::get( ) -> EStateAccess
+{
+    return s_stateAccess;
+}
+
+auto CStateAccess::isDirect( ) -> bool
+{
+    return EStateAccess::Direct == s_stateAccess;
+}
+
+auto CStateAccess::isVertexAttribBinding( ) -> bool
+{
+    return s_isVertexAttribBinding;
+}
@@ -0,0 +1,65 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+
+class CDeviceCaps;
+
+enum class EStateAccess : std::uint8_t
+{
+    BindToEdit = 0,
+    Direct     = 1,
+};
+
+/// Selects how the buffer and vertex array objects are created and edited.
+///
+/// Direct state access (OpenGL 4.5 or GL_ARB_direct_state_access) edits the objects by name without touching the
+/// bindings. Bind-to-edit is the fallback for the OpenGL 4.3 and 4.1 contexts.
+///
+/// Separate vertex formats (OpenGL 4.3 or GL_ARB_vertex_attrib_binding) keep the attribute formats of a vertex array
+/// apart from its vertex buffers. The OpenGL 4.1 fallback specifies the attribute pointers again for every buffer.
+class CStateAccess
+{
+public:
+    CStateAccess( )                                     = delete;
+    ~CStateAccess( )                                    = delete;
+
+    CStateAccess(CStateAccess const & other)            = delete;
+    CStateAccess& operator=(CStateAccess const & other) = delete;
+
+    CStateAccess(CStateAccess&& other)                  = delete;
+    CStateAccess& operator=(CStateAccess&& other)       = delete;
+
+public:
+    static auto select(CDeviceCaps const & deviceCaps, bool const allowDirect = true) -> EStateAccess;
+
+    static auto get( ) -> EStateAccess;
+    static auto isDirect( ) -> bool;
+    static auto isVertexAttribBinding( ) -> bool;
+};
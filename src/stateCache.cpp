@@ -0,0 +1,211 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "stateCache.hpp"
+#include "error.hpp"
+
+#include <stdexcept>
+
+auto CStateCache::get( ) -> CStateCache&
+{
+    // An OpenGL context is current on one thread at a time, the cache of the thread is the cache of its context.
+    thread_local CStateCache stateCache{ };
+    return stateCache;
+}
+
+auto CStateCache::useProgram(GLuint const program) -> void
+{
+    if(update(m_program, program))
+    {
+        GLCheck(glUseProgram(program));
+    }
+}
+
+auto CStateCache::bindProgramPipeline(GLuint const programPipeline) -> void
+{
+    // The current program takes precedence over the bound pipeline.
+    useProgram(0);
+    if(update(m_programPipeline, programPipeline))
+    {
+        GLCheck(glBindProgramPipeline(programPipeline));
+    }
+}
+
+auto CStateCache::bindVertexArray(GLuint const vertexArray) -> void
+{
+    if(update(m_vertexArray, vertexArray))
+    {
+        GLCheck(glBindVertexArray(vertexArray));
+        m_elementArrayBuffer = k_unknown;
+    }
+}
+
+auto CStateCache::bindBuffer(GLenum const target, GLuint const buffer) -> void
+{
+    GLuint* const binding{getBufferBinding(target)};
+    if(nullptr == binding)
+    {
+        ++m_statistics.m_numIssued;
+        GLCheck(glBindBuffer(target, buffer));
+    }
+    else if(update(*binding, buffer))
+    {
+        GLCheck(glBindBuffer(target, buffer));
+    }
+}
+
+auto CStateCache::bindTexture(GLuint const unit, GLenum const target, GLuint const texture) -> void
+{
+    if(unit >= k_maxTextureUnits)
+    {
+        throw std::out_of_range("The texture unit exceeds the texture units of the state cache.");
+    }
+
+    // Only the last target of each unit is tracked, binding another target always issues the call.
+    CTextureBinding& binding{m_textures.at(unit)};
+    if((binding.m_target == target) && (binding.m_texture == texture))
+    {
+        ++m_statistics.m_numSkipped;
+        return;
+    }
+    binding = {target, texture};
+    ++m_statistics.m_numIssued;
+
+    if(update(m_activeTextureUnit, unit))
+    {
+        GLCheck(glActiveTexture(GL_TEXTURE0 + unit));
+    }
+    GLCheck(glBindTexture(target, texture));
+}
+
+auto CStateCache::forgetProgram(GLuint const program) -> void
+{
+    // Deleting the current program does not unbind it, the program is deleted when it is no longer in use.
+    if(m_program == program)
+    {
+        m_program = k_unknown;
+    }
+}
+
+auto CStateCache::forgetProgramPipeline(GLuint const programPipeline) -> void
+{
+    // Deleting a bound object reverts the binding to zero.
+    if(m_programPipeline == programPipeline)
+    {
+        m_programPipeline = 0;
+    }
+}
+
+auto CStateCache::forgetVertexArray(GLuint const vertexArray) -> void
+{
+    // Deleting a bound object reverts the binding to zero.
+    if(m_vertexArray == vertexArray)
+    {
+        m_vertexArray        = 0;
+        m_elementArrayBuffer = k_unknown;
+    }
+}
+
+auto CStateCache::forgetElementArrayBuffer(GLuint const vertexArray) -> void
+{
+    // The element array buffer of the vertex array was changed without binding it.
+    if(m_vertexArray == vertexArray)
+    {
+        m_elementArrayBuffer = k_unknown;
+    }
+}
+
+auto CStateCache::forgetBuffer(GLuint const buffer) -> void
+{
+    for(GLuint* binding :
+        {&m_arrayBuffer, &m_elementArrayBuffer, &m_copyReadBuffer, &m_copyWriteBuffer, &m_uniformBuffer,
+         &m_drawIndirectBuffer})
+    {
+        if(*binding == buffer)
+        {
+            *binding = 0;
+        }
+    }
+}
+
+auto CStateCache::forgetTexture(GLuint const texture) -> void
+{
+    for(CTextureBinding& binding : m_textures)
+    {
+        if(binding.m_texture == texture)
+        {
+            binding.m_texture = 0;
+        }
+    }
+}
+
+auto CStateCache::invalidate( ) -> void
+{
+    CStatistics const statistics{m_statistics};
+    *this        = { };
+    m_statistics = statistics;
+}
+
+auto CStateCache::getStatistics( ) const -> CStatistics
+{
+    return m_statistics;
+}
+
+auto CStateCache::resetStatistics( ) -> void
+{
+    m_statistics = { };
+}
+
+auto CStateCache::getBufferBinding(GLenum const target) -> GLuint*
+{
+    GLuint* binding{ };
+    // clang-format off
+    switch(target)
+    {
+    case GL_ARRAY_BUFFER:           binding = &m_arrayBuffer; break;
+    case GL_ELEMENT_ARRAY_BUFFER:   binding = &m_elementArrayBuffer; break;
+    case GL_COPY_READ_BUFFER:       binding = &m_copyReadBuffer; break;
+    case GL_COPY_WRITE_BUFFER:      binding = &m_copyWriteBuffer; break;
+    case GL_UNIFORM_BUFFER:         binding = &m_uniformBuffer; break;
+    case GL_DRAW_INDIRECT_BUFFER:   binding = &m_drawIndirectBuffer; break;
+    }
+    // clang-format on
+    return binding;
+}
+
+auto CStateCache::update(GLuint& binding, GLuint const object) -> bool
+{
+    if(binding == object)
+    {
+        ++m_statistics.m_numSkipped;
+        return false;
+    }
+
+    binding = object;
+    ++m_statistics.m_numIssued;
+    return true;
+}
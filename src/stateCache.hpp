@@ -0,0 +1,96 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "glad/glad.h"
+
+#include <array>
+#include <cstdint>
+
+/// Shadow copy of the bindings of the OpenGL context current on the calling thread.
+///
+/// Every bind goes through the cache, which skips the calls that would not change the bound object. The element array
+/// buffer binding is part of the vertex array state and is therefore forgotten whenever the vertex array changes.
+/// Objects bound by other means than the cache require a call of invalidate( ).
+class CStateCache
+{
+public:
+    static constexpr std::size_t k_maxTextureUnits{32};
+
+    struct CStatistics
+    {
+        std::uint64_t m_numIssued{ };
+        std::uint64_t m_numSkipped{ };
+    };
+
+public:
+    static auto get( ) -> CStateCache&;
+
+    auto        useProgram(GLuint const program) -> void;
+    auto        bindProgramPipeline(GLuint const programPipeline) -> void;
+    auto        bindVertexArray(GLuint const vertexArray) -> void;
+    auto        bindBuffer(GLenum const target, GLuint const buffer) -> void;
+    auto        bindTexture(GLuint const unit, GLenum const target, GLuint const texture) -> void;
+
+    auto        forgetProgram(GLuint const program) -> void;
+    auto        forgetProgramPipeline(GLuint const programPipeline) -> void;
+    auto        forgetVertexArray(GLuint const vertexArray) -> void;
+    auto        forgetElementArrayBuffer(GLuint const vertexArray) -> void;
+    auto        forgetBuffer(GLuint const buffer) -> void;
+    auto        forgetTexture(GLuint const texture) -> void;
+    auto        invalidate( ) -> void;
+
+    auto        getStatistics( ) const -> CStatistics;
+    auto        resetStatistics( ) -> void;
+
+private:
+    static constexpr GLuint k_unknown{~GLuint{ }};
+
+    struct CTextureBinding
+    {
+        GLenum m_target{ };
+        GLuint m_texture{k_unknown};
+    };
+
+    auto        getBufferBinding(GLenum const target) -> GLuint*;
+    auto        update(GLuint& binding, GLuint const object) -> bool;
+
+private:
+    GLuint                                         m_program{k_unknown};
+    GLuint                                         m_programPipeline{k_unknown};
+    GLuint                                         m_vertexArray{k_unknown};
+    GLuint                                         m_arrayBuffer{k_unknown};
+    GLuint                                         m_elementArrayBuffer{k_unknown};
+    GLuint                                         m_copyReadBuffer{k_unknown};
+    GLuint                                         m_copyWriteBuffer{k_unknown};
+    GLuint                                         m_uniformBuffer{k_unknown};
+    GLuint                                         m_drawIndirectBuffer{k_unknown};
+    GLuint                                         m_activeTextureUnit{k_unknown};
+    std::array<CTextureBinding, k_maxTextureUnits> m_textures{ };
+    CStatistics                                    m_statistics{ };
+};
@@ -30,6 +30,7 @@
 
 #include "fmt/core.h"
 
+#include <algorithm>
 #include <array>
 
 auto CStateVariables::getExtensions( ) -> std::vector<std::string>
@@ -0,0 +1,171 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "vertexBufferElement.hpp"
+#include "vertexPacking.hpp"
+
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+/// Compile-time layout of a vertex struct, specialized per vertex type with a constexpr array k_elements, e.g.
+///
+///     template<>
+///     struct CStaticVertexBufferLayout<CVertex>
+///     {
+///         static constexpr std::array k_elements{
+///             LEARNOGL_VERTEX_BUFFER_ELEMENT(CVertex, m_position, EVertexAttributeIndex::Zero),
+///         };
+///     };
+///
+/// The component type and count are deduced from the member type, the offset from offsetof.
+template<typename TVertex>
+struct CStaticVertexBufferLayout;
+
+#define LEARNOGL_VERTEX_BUFFER_ELEMENT(vertex, member, attributeIndex)                                                 \
+    makeVertexBufferElement<decltype(vertex::member)>(attributeIndex, offsetof(vertex, member), GL_FALSE)
+#define LEARNOGL_VERTEX_BUFFER_ELEMENT_NORMALIZED(vertex, member, attributeIndex)                                      \
+    makeVertexBufferElement<decltype(vertex::member)>(attributeIndex, offsetof(vertex, member), GL_TRUE)
+
+template<typename TComponent>
+struct CVertexComponentType;
+
+// clang-format off
+template<> struct CVertexComponentType<GLbyte>         { static constexpr GLenum k_type{GL_BYTE}; };
+template<> struct CVertexComponentType<GLubyte>        { static constexpr GLenum k_type{GL_UNSIGNED_BYTE}; };
+template<> struct CVertexComponentType<GLshort>        { static constexpr GLenum k_type{GL_SHORT}; };
+template<> struct CVertexComponentType<GLushort>       { static constexpr GLenum k_type{GL_UNSIGNED_SHORT}; };
+template<> struct CVertexComponentType<GLint>          { static constexpr GLenum k_type{GL_INT}; };
+template<> struct CVertexComponentType<GLuint>         { static constexpr GLenum k_type{GL_UNSIGNED_INT}; };
+template<> struct CVertexComponentType<GLfloat>        { static constexpr GLenum k_type{GL_FLOAT}; };
+template<> struct CVertexComponentType<CHalfFloat>     { static constexpr GLenum k_type{GL_HALF_FLOAT}; };
+template<> struct CVertexComponentType<CInt2101010Rev> { static constexpr GLenum k_type{GL_INT_2_10_10_10_REV}; };
+// clang-format on
+
+/// Component type and count of a vertex struct member: a scalar, a std::array, a C array, a glm vector or a packed
+/// CInt2101010Rev.
+template<typename TMember>
+struct CVertexAttributeTraits
+{
+    using Component = TMember;
+    static constexpr std::size_t k_numComponents{1};
+    static constexpr bool        k_isPacked{false};
+};
+
+template<>
+struct CVertexAttributeTraits<CInt2101010Rev>
+{
+    using Component = CInt2101010Rev;
+    static constexpr std::size_t k_numComponents{4};
+    static constexpr bool        k_isPacked{true};
+};
+
+template<typename TComponent, std::size_t N>
+struct CVertexAttributeTraits<std::array<TComponent, N>>
+{
+    using Component = TComponent;
+    static constexpr std::size_t k_numComponents{N};
+    static constexpr bool        k_isPacked{false};
+};
+
+template<typename TComponent, std::size_t N>
+struct CVertexAttributeTraits<TComponent[N]>
+{
+    using Component = TComponent;
+    static constexpr std::size_t k_numComponents{N};
+    static constexpr bool        k_isPacked{false};
+};
+
+template<glm::length_t L, typename TComponent, glm::qualifier Q>
+struct CVertexAttributeTraits<glm::vec<L, TComponent, Q>>
+{
+    using Component = TComponent;
+    static constexpr std::size_t k_numComponents{static_cast<std::size_t>(L)};
+    static constexpr bool        k_isPacked{false};
+};
+
+template<typename TMember>
+constexpr auto makeVertexBufferElement(
+    EVertexAttributeIndex const vertexAttributeIndex, std::size_t const offset, GLboolean const normalized)
+    -> CVertexBufferElement
+{
+    using Traits    = CVertexAttributeTraits<std::remove_cv_t<TMember>>;
+    using Component = typename Traits::Component;
+
+    static_assert(
+        (Traits::k_numComponents >= 1) && (Traits::k_numComponents <= 4),
+        "A vertex attribute has one to four components.");
+    static_assert(
+        sizeof(TMember) == (sizeof(Component) * (Traits::k_isPacked ? 1 : Traits::k_numComponents)),
+        "The components of a vertex attribute are tightly packed.");
+
+    return {
+        vertexAttributeIndex,
+        static_cast<ENumberOfComponents>(Traits::k_numComponents),
+        CVertexComponentType<Component>::k_type,
+        static_cast<GLint>(sizeof(Component)),
+        normalized,
+        static_cast<GLuint>(offset)};
+}
+
+template<typename TVertex, std::size_t N>
+constexpr auto areVertexBufferElementsInside(std::array<CVertexBufferElement, N> const & elements) -> bool
+{
+    for(CVertexBufferElement const & element : elements)
+    {
+        if((element.m_offset + getVertexBufferElementSize(element)) > sizeof(TVertex))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// The elements neither overlap nor share an attribute index.
+template<std::size_t N>
+constexpr auto areVertexBufferElementsDisjoint(std::array<CVertexBufferElement, N> const & elements) -> bool
+{
+    for(std::size_t i{ }; i < N; ++i)
+    {
+        for(std::size_t j{i + 1}; j < N; ++j)
+        {
+            GLuint const endI{elements[i].m_offset + getVertexBufferElementSize(elements[i])};
+            GLuint const endJ{elements[j].m_offset + getVertexBufferElementSize(elements[j])};
+            bool const   isOverlapping{(endI > elements[j].m_offset) && (endJ > elements[i].m_offset)};
+            if(isOverlapping || (elements[i].m_vertexAttributeIndex == elements[j].m_vertexAttributeIndex))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,316 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "streamingBuffer.hpp"
+#include "deviceCaps.hpp"
+#include "error.hpp"
+#include "stateCache.hpp"
+#include "stateAccess.hpp"
+
+#include "fmt/core.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+constexpr GLuint64   k_waitTimeout{1'000'000};
+constexpr GLbitfield k_persistentMapFlags{GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT};
+constexpr GLbitfield k_unsynchronizedMapFlags{
+    GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT};
+}
+
+CStreamingBuffer::~CStreamingBuffer( )
+{
+    destroy( );
+}
+
+CStreamingBuffer::CStreamingBuffer(CStreamingBuffer&& other)
+{
+    *this = std::move(other);
+}
+
+CStreamingBuffer& CStreamingBuffer::operator=(CStreamingBuffer&& other)
+{
+    if(this != &other)
+    {
+        destroy( );
+        m_bufferId            = std::exchange(other.m_bufferId, { });
+        m_target              = std::exchange(other.m_target, { });
+        m_regionSize          = std::exchange(other.m_regionSize, { });
+        m_fences              = std::exchange(other.m_fences, { });
+        m_region              = std::exchange(other.m_region, { });
+        m_regionOffset        = std::exchange(other.m_regionOffset, { });
+        m_isRegionReady       = std::exchange(other.m_isRegionReady, { });
+        m_isAllocationPending = std::exchange(other.m_isAllocationPending, { });
+        m_mappedData          = std::exchange(other.m_mappedData, { });
+        m_statistics          = std::exchange(other.m_statistics, { });
+    }
+    return *this;
+}
+
+auto CStreamingBuffer::create(
+    CDeviceCaps const & deviceCaps, GLenum const target, GLsizeiptr const regionSize, std::size_t const numRegions)
+    -> void
+{
+    destroy( );
+
+    if((regionSize <= 0) || (0 == numRegions))
+    {
+        throw std::runtime_error(
+            fmt::format("Invalid streaming buffer of {} regions with {} bytes each.", numRegions, regionSize));
+    }
+
+    m_target     = target;
+    m_regionSize = regionSize;
+    m_fences.assign(numRegions, nullptr);
+    m_statistics = { };
+
+    GLsizeiptr const size{regionSize * static_cast<GLsizeiptr>(numRegions)};
+    bool const       hasBufferStorage{
+        (deviceCaps.isVersion(4, 4) || deviceCaps.hasExtension(EExtension::ArbBufferStorage)) &&
+        (nullptr != glad_glBufferStorage)};
+
+    if(hasBufferStorage && CStateAccess::isDirect( ))
+    {
+        GLCheck(glCreateBuffers(1, &m_bufferId));
+        GLCheck(glNamedBufferStorage(m_bufferId, size, nullptr, k_persistentMapFlags));
+        GLCheck(
+            m_mappedData = static_cast<std::byte*>(glMapNamedBufferRange(m_bufferId, 0, size, k_persistentMapFlags)));
+    }
+    else if(hasBufferStorage)
+    {
+        GLCheck(glGenBuffers(1, &m_bufferId));
+        bind( );
+        GLCheck(glBufferStorage(m_target, size, nullptr, k_persistentMapFlags));
+        GLCheck(m_mappedData = static_cast<std::byte*>(glMapBufferRange(m_target, 0, size, k_persistentMapFlags)));
+    }
+    else
+    {
+        GLCheck(glGenBuffers(1, &m_bufferId));
+        bind( );
+        GLCheck(glBufferData(m_target, size, nullptr, GL_STREAM_DRAW));
+    }
+
+    if(hasBufferStorage && (nullptr == m_mappedData))
+    {
+        throw std::runtime_error("Failed to map the streaming buffer persistently.");
+    }
+
+    spdlog::info(
+        "Streaming buffer of {} regions with {} bytes each, {} mapping.", numRegions, regionSize,
+        hasBufferStorage ? "persistent" : "unsynchronized");
+}
+
+auto CStreamingBuffer::destroy( ) -> void
+{
+    if(0 == m_bufferId)
+    {
+        return;
+    }
+
+    std::for_each(m_fences.begin( ), m_fences.end( ), [](GLsync const fence) {
+        if(nullptr != fence)
+        {
+            GLCheck(glDeleteSync(fence));
+        }
+    });
+
+    // Deleting the buffer unmaps it as well
+    GLCheck(glDeleteBuffers(1, &m_bufferId));
+    CStateCache::get( ).forgetBuffer(m_bufferId);
+
+    m_bufferId            = { };
+    m_target              = { };
+    m_regionSize          = { };
+    m_fences.clear( );
+    m_region              = { };
+    m_regionOffset        = { };
+    m_isRegionReady       = { };
+    m_isAllocationPending = { };
+    m_mappedData          = { };
+}
+
+auto CStreamingBuffer::allocate(GLsizeiptr const size, GLsizeiptr const alignment) -> CStreamingAllocation
+{
+    if(m_isAllocationPending)
+    {
+        throw std::runtime_error("The previous allocation of the streaming buffer has not been finished.");
+    }
+
+    if(!m_isRegionReady)
+    {
+        waitForRegion( );
+    }
+
+    GLsizeiptr const offset{((m_regionOffset + alignment - 1) / alignment) * alignment};
+    if((offset + size) > m_regionSize)
+    {
+        throw std::runtime_error(fmt::format(
+            "The streaming buffer region of {} bytes can not hold {} more bytes at offset {}.", m_regionSize, size,
+            offset));
+    }
+    m_regionOffset = offset + size;
+
+    GLintptr const bufferOffset{(static_cast<GLintptr>(m_region) * m_regionSize) + offset};
+    if(isPersistent( ))
+    {
+        m_isAllocationPending = true;
+        return {m_mappedData + bufferOffset, bufferOffset, size};
+    }
+
+    // The fences guard the regions, the driver does not need to synchronize the mapping
+    GLvoid* data{ };
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(data = glMapNamedBufferRange(m_bufferId, bufferOffset, size, k_unsynchronizedMapFlags));
+    }
+    else
+    {
+        bind( );
+        GLCheck(data = glMapBufferRange(m_target, bufferOffset, size, k_unsynchronizedMapFlags));
+    }
+
+    if(nullptr == data)
+    {
+        throw std::runtime_error("Failed to map the streaming buffer range.");
+    }
+    m_isAllocationPending = true;
+    return {data, bufferOffset, size};
+}
+
+auto CStreamingBuffer::finish(CStreamingAllocation const & allocation) -> void
+{
+    m_isAllocationPending = false;
+    if(isPersistent( ) || (nullptr == allocation.m_data))
+    {
+        return;
+    }
+
+    GLboolean isUnmapped{ };
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(isUnmapped = glUnmapNamedBuffer(m_bufferId));
+    }
+    else
+    {
+        bind( );
+        GLCheck(isUnmapped = glUnmapBuffer(m_target));
+    }
+
+    if(GL_FALSE == isUnmapped)
+    {
+        spdlog::warn("The streaming buffer range at offset {} was corrupted while mapped.", allocation.m_offset);
+    }
+}
+
+auto CStreamingBuffer::endFrame( ) -> void
+{
+    if(0 < m_regionOffset)
+    {
+        GLCheck(m_fences.at(m_region) = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    }
+
+    m_region        = (m_region + 1) % m_fences.size( );
+    m_regionOffset  = { };
+    m_isRegionReady = false;
+    ++m_statistics.m_numFrames;
+}
+
+auto CStreamingBuffer::getId( ) const -> GLuint
+{
+    return m_bufferId;
+}
+
+auto CStreamingBuffer::getTarget( ) const -> GLenum
+{
+    return m_target;
+}
+
+auto CStreamingBuffer::getRegionSize( ) const -> GLsizeiptr
+{
+    return m_regionSize;
+}
+
+auto CStreamingBuffer::getNumRegions( ) const -> std::size_t
+{
+    return m_fences.size( );
+}
+
+auto CStreamingBuffer::isPersistent( ) const -> bool
+{
+    return nullptr != m_mappedData;
+}
+
+auto CStreamingBuffer::getStatistics( ) const -> CStatistics
+{
+    return m_statistics;
+}
+
+auto CStreamingBuffer::bind( ) const -> void
+{
+    CStateCache::get( ).bindBuffer(m_target, m_bufferId);
+}
+
+auto CStreamingBuffer::waitForRegion( ) -> void
+{
+    m_isRegionReady = true;
+
+    GLsync& fence{m_fences.at(m_region)};
+    if(nullptr == fence)
+    {
+        return;
+    }
+
+    // Only the oldest region is reused, the GPU is behind by the whole ring if its fence is not signaled yet
+    GLCheck(GLenum waitResult{glClientWaitSync(fence, 0, 0)});
+    if(GL_TIMEOUT_EXPIRED == waitResult)
+    {
+        auto const start{std::chrono::steady_clock::now( )};
+        while(GL_TIMEOUT_EXPIRED == waitResult)
+        {
+            GLCheck(waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, k_waitTimeout));
+        }
+        auto const stallTime{std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now( ) - start)};
+
+        ++m_statistics.m_numStalls;
+        m_statistics.m_stallTime    += stallTime;
+        m_statistics.m_maxStallTime  = std::max(m_statistics.m_maxStallTime, stallTime);
+        spdlog::debug("Streaming buffer stalled for {} us on region {}.", stallTime.count( ) / 1000, m_region);
+    }
+
+    GLCheck(glDeleteSync(fence));
+    fence = nullptr;
+
+    if(GL_WAIT_FAILED == waitResult)
+    {
+        throw std::runtime_error("Failed to wait for the fence of the streaming buffer region.");
+    }
+}
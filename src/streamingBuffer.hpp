@@ -0,0 +1,114 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "glad/glad.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CDeviceCaps;
+
+/// Sub-allocation of a streaming buffer, valid until the end of the frame.
+struct CStreamingAllocation
+{
+    GLvoid*    m_data{ };
+    GLintptr   m_offset{ };
+    GLsizeiptr m_size{ };
+};
+
+/// Ring of per-frame regions in a single buffer object, written by the CPU while the GPU reads the older regions.
+///
+/// The buffer is persistently and coherently mapped if the context supports immutable buffer storage. Otherwise every
+/// allocation maps its range unsynchronized and has to be finished, which unmaps it. Each region is guarded by a fence
+/// that is inserted at the end of the frame; reusing a region waits for its fence only.
+///
+/// A buffer can not be mapped twice, so only one allocation may be outstanding: allocate( ) throws until the previous
+/// allocation is finished. Both mappings enforce this, the persistent one would allow more.
+class CStreamingBuffer
+{
+public:
+    static constexpr std::size_t k_defaultNumRegions{3};
+
+    struct CStatistics
+    {
+        std::uint64_t            m_numFrames{ };
+        std::uint64_t            m_numStalls{ };
+        std::chrono::nanoseconds m_stallTime{ };
+        std::chrono::nanoseconds m_maxStallTime{ };
+    };
+
+public:
+    CStreamingBuffer( ) = default;
+    ~CStreamingBuffer( );
+
+    CStreamingBuffer(CStreamingBuffer const & other)            = delete;
+    CStreamingBuffer& operator=(CStreamingBuffer const & other) = delete;
+
+    CStreamingBuffer(CStreamingBuffer&& other);
+    CStreamingBuffer& operator=(CStreamingBuffer&& other);
+
+public:
+    auto create(
+        CDeviceCaps const & deviceCaps,
+        GLenum const        target,
+        GLsizeiptr const    regionSize,
+        std::size_t const   numRegions = k_defaultNumRegions) -> void;
+    auto destroy( ) -> void;
+
+    auto allocate(GLsizeiptr const size, GLsizeiptr const alignment = 4) -> CStreamingAllocation;
+    auto finish(CStreamingAllocation const & allocation) -> void;
+    auto endFrame( ) -> void;
+
+    auto getId( ) const -> GLuint;
+    auto getTarget( ) const -> GLenum;
+    auto getRegionSize( ) const -> GLsizeiptr;
+    auto getNumRegions( ) const -> std::size_t;
+    auto isPersistent( ) const -> bool;
+
+    auto getStatistics( ) const -> CStatistics;
+
+    auto bind( ) const -> void;
+
+private:
+    auto waitForRegion( ) -> void;
+
+private:
+    GLuint              m_bufferId{ };
+    GLenum              m_target{ };
+    GLsizeiptr          m_regionSize{ };
+    std::vector<GLsync> m_fences{ };
+    std::size_t         m_region{ };
+    GLsizeiptr          m_regionOffset{ };
+    bool                m_isRegionReady{ };
+    bool                m_isAllocationPending{ };
+    std::byte*          m_mappedData{ };
+    CStatistics         m_statistics{ };
+};
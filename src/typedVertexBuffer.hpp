@@ -0,0 +1,116 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "vertexBuffer.hpp"
+#include "staticVertexBufferLayout.hpp"
+#include "bufferUsagePattern.hpp"
+
+#include "glad/glad.h"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+/// Vertex buffer of TVertex, laid out by CStaticVertexBufferLayout<TVertex>.
+///
+/// The stride is sizeof(TVertex) and the layout is validated at compile time, the sizes passed to the buffer can not
+/// disagree with the vertex struct.
+template<typename TVertex>
+class CTypedVertexBuffer
+{
+public:
+    using Vertex = TVertex;
+
+    static constexpr auto const & k_elements{CStaticVertexBufferLayout<TVertex>::k_elements};
+    static constexpr GLsizei      k_stride{static_cast<GLsizei>(sizeof(TVertex))};
+
+    static_assert(std::is_standard_layout_v<TVertex>, "The offsets of the vertex members require a standard layout.");
+    static_assert(std::is_trivially_copyable_v<TVertex>, "The vertices are copied to the buffer bytewise.");
+    static_assert(!k_elements.empty( ), "The vertex layout has at least one element.");
+    static_assert(areVertexBufferElementsInside<TVertex>(k_elements), "A vertex element exceeds the vertex struct.");
+    static_assert(areVertexBufferElementsDisjoint(k_elements), "The vertex elements overlap or share an attribute.");
+
+public:
+    auto create(
+        TVertex const * const     vertices,
+        GLsizeiptr const          count,
+        EBufferUsagePattern const usage = EBufferUsagePattern::StaticDraw) -> void
+    {
+        m_vertexBuffer.create(vertices, k_stride, count, usage);
+        m_count = static_cast<GLsizei>(count);
+    }
+
+    template<std::size_t N>
+    auto create(
+        std::array<TVertex, N> const & vertices, EBufferUsagePattern const usage = EBufferUsagePattern::StaticDraw)
+        -> void
+    {
+        create(vertices.data( ), static_cast<GLsizeiptr>(N), usage);
+    }
+
+    auto destroy( ) -> void
+    {
+        m_vertexBuffer.destroy( );
+        m_count = { };
+    }
+
+    auto update(GLintptr const first, TVertex const * const vertices, GLsizeiptr const count) -> void
+    {
+        m_vertexBuffer.update(first * k_stride, vertices, count * k_stride);
+    }
+
+    auto getId( ) const -> GLuint
+    {
+        return m_vertexBuffer.getId( );
+    }
+
+    auto getCount( ) const -> GLsizei
+    {
+        return m_count;
+    }
+
+    auto getVertexBuffer( ) const -> CVertexBuffer const &
+    {
+        return m_vertexBuffer;
+    }
+
+    auto bind( ) const -> void
+    {
+        m_vertexBuffer.bind( );
+    }
+
+    auto unbind( ) const -> void
+    {
+        m_vertexBuffer.unbind( );
+    }
+
+private:
+    CVertexBuffer m_vertexBuffer{ };
+    GLsizei       m_count{ };
+};
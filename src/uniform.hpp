@@ -0,0 +1,74 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "hash.hpp"
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/// Name of a uniform variable, hashed at compile time when declared constexpr.
+///
+/// Arrays are named without the [0] suffix of their first element.
+struct CUniformName
+{
+    constexpr CUniformName(std::string_view const name)
+        : m_hash{fnv1a(name)}
+    {
+    }
+
+    constexpr CUniformName(char const * const name)
+        : CUniformName{std::string_view{name}}
+    {
+    }
+
+    std::uint64_t m_hash{ };
+};
+
+/// Active uniform variable of a linked program, outside of the uniform blocks.
+struct CUniform
+{
+    std::uint64_t m_hash{ };
+    std::string   m_name{ };
+    GLenum        m_type{ };
+    GLint         m_arraySize{ };
+    GLint         m_location{-1};
+};
+
+/// Active uniform block of a linked program, bound to the binding point shared by all blocks of the same name.
+struct CUniformBlock
+{
+    std::uint64_t m_hash{ };
+    std::string   m_name{ };
+    GLuint        m_index{ };
+    GLuint        m_binding{ };
+    GLint         m_dataSize{ };
+};
@@ -0,0 +1,117 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "uniformBlockBindings.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+std::mutex                                s_bindingsMutex{ };
+std::unordered_map<std::uint64_t, GLuint> s_bindings{ };
+std::vector<bool>                         s_isBindingUsed{ };
+
+auto isBindingUsed(GLuint const binding) -> bool
+{
+    return (binding < s_isBindingUsed.size( )) && s_isBindingUsed.at(binding);
+}
+
+auto useBinding(std::uint64_t const hash, GLuint const binding) -> void
+{
+    if(binding >= s_isBindingUsed.size( ))
+    {
+        s_isBindingUsed.resize(binding + 1);
+    }
+    s_isBindingUsed.at(binding) = true;
+    s_bindings.emplace(hash, binding);
+}
+
+auto getFreeBinding( ) -> GLuint
+{
+    GLuint binding{ };
+    while(isBindingUsed(binding))
+    {
+        ++binding;
+    }
+    return binding;
+}
+}
+
+auto CUniformBlockBindings::getBinding(CUniformName const name) -> GLuint
+{
+    std::lock_guard<std::mutex> const lock{s_bindingsMutex};
+
+    auto const iter{s_bindings.find(name.m_hash)};
+    if(iter != s_bindings.end( ))
+    {
+        return std::get<1>(*iter);
+    }
+
+    GLuint const binding{getFreeBinding( )};
+    useBinding(name.m_hash, binding);
+    return binding;
+}
+
+auto CUniformBlockBindings::reserveBinding(std::string_view const name, GLuint const binding) -> GLuint
+{
+    std::lock_guard<std::mutex> const lock{s_bindingsMutex};
+
+    std::uint64_t const hash{CUniformName{name}.m_hash};
+    auto const          iter{s_bindings.find(hash)};
+    if(iter != s_bindings.end( ))
+    {
+        if(std::get<1>(*iter) != binding)
+        {
+            spdlog::warn(
+                R"(The uniform block "{}" is bound to {} elsewhere instead of {}.)", name, std::get<1>(*iter), binding);
+        }
+        return std::get<1>(*iter);
+    }
+
+    GLuint result{binding};
+    if(isBindingUsed(binding))
+    {
+        result = getFreeBinding( );
+        spdlog::warn(
+            R"(The binding {} of the uniform block "{}" is taken, {} is used instead.)", binding, name, result);
+    }
+    useBinding(hash, result);
+    return result;
+}
+
+auto CUniformBlockBindings::clear( ) -> void
+{
+    std::lock_guard<std::mutex> const lock{s_bindingsMutex};
+    s_bindings.clear( );
+    s_isBindingUsed.clear( );
+}
@@ -0,0 +1,58 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "uniform.hpp"
+
+#include "glad/glad.h"
+
+#include <string_view>
+
+/// Binding points of the uniform blocks, shared by all programs that declare a block of the same name.
+///
+/// CProgram assigns the bindings after linking, so the buffer range bound for a block serves every program. A block
+/// with a non-zero binding in the shader keeps it, unless another block name took that binding first.
+class CUniformBlockBindings
+{
+public:
+    CUniformBlockBindings( )                                              = delete;
+    ~CUniformBlockBindings( )                                             = delete;
+
+    CUniformBlockBindings(CUniformBlockBindings const & other)            = delete;
+    CUniformBlockBindings& operator=(CUniformBlockBindings const & other) = delete;
+
+    CUniformBlockBindings(CUniformBlockBindings&& other)                  = delete;
+    CUniformBlockBindings& operator=(CUniformBlockBindings&& other)       = delete;
+
+public:
+    /// Binding of the block, the lowest free one is assigned on the first request.
+    static auto getBinding(CUniformName const name) -> GLuint;
+    /// Requests the binding for the block and returns the one it gets.
+    static auto reserveBinding(std::string_view const name, GLuint const binding) -> GLuint;
+    static auto clear( ) -> void;
+};
@@ -0,0 +1,144 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+
+#include <array>
+#include <cstddef>
+
+/// Memory layouts of uniform and shader storage blocks.
+enum class EBlockLayout
+{
+    Std140,
+    Std430,
+};
+
+/// Rounds the offset up to the next multiple of the alignment.
+constexpr auto alignOffset(std::size_t const offset, std::size_t const alignment) -> std::size_t
+{
+    return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+/// Base alignment and size of a block member by the rules of the OpenGL specification, section 7.6.2.2. Supported are
+/// 32-bit scalars, vectors, column-major matrices and arrays of them, nested structures are not.
+template<EBlockLayout Layout, typename TMember>
+struct CBlockMember;
+
+template<EBlockLayout Layout>
+struct CBlockMember<Layout, GLfloat>
+{
+    static constexpr std::size_t k_alignment{4};
+    static constexpr std::size_t k_size{4};
+};
+
+template<EBlockLayout Layout>
+struct CBlockMember<Layout, GLint>
+{
+    static constexpr std::size_t k_alignment{4};
+    static constexpr std::size_t k_size{4};
+};
+
+template<EBlockLayout Layout>
+struct CBlockMember<Layout, GLuint>
+{
+    static constexpr std::size_t k_alignment{4};
+    static constexpr std::size_t k_size{4};
+};
+
+/// Two-component vectors are aligned to twice the scalar, three- and four-component vectors to four times the scalar.
+template<EBlockLayout Layout, glm::length_t L, typename T, glm::qualifier Q>
+struct CBlockMember<Layout, glm::vec<L, T, Q>>
+{
+    static constexpr std::size_t k_alignment{CBlockMember<Layout, T>::k_size * ((2 == L) ? 2 : 4)};
+    static constexpr std::size_t k_size{CBlockMember<Layout, T>::k_size * L};
+};
+
+/// Arrays place their elements at a stride of the element size rounded up to the element alignment, which std140
+/// rounds up to the alignment of a vec4 as well.
+template<EBlockLayout Layout, typename TElement, std::size_t N>
+struct CBlockMember<Layout, std::array<TElement, N>>
+{
+    static constexpr std::size_t k_alignment{
+        (EBlockLayout::Std140 == Layout) ? alignOffset(CBlockMember<Layout, TElement>::k_alignment, 16)
+                                         : CBlockMember<Layout, TElement>::k_alignment};
+    static constexpr std::size_t k_stride{alignOffset(CBlockMember<Layout, TElement>::k_size, k_alignment)};
+    static constexpr std::size_t k_size{k_stride * N};
+};
+
+template<EBlockLayout Layout, typename TElement, std::size_t N>
+struct CBlockMember<Layout, TElement[N]> : CBlockMember<Layout, std::array<TElement, N>>
+{
+};
+
+/// Matrices are stored like arrays of their column vectors.
+template<EBlockLayout Layout, glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+struct CBlockMember<Layout, glm::mat<C, R, T, Q>>
+    : CBlockMember<Layout, std::array<glm::vec<R, T, Q>, static_cast<std::size_t>(C)>>
+{
+};
+
+/// Offsets of the members of a block in the order of their declaration.
+template<EBlockLayout Layout, typename... TMembers>
+constexpr auto getBlockOffsets( ) -> std::array<std::size_t, sizeof...(TMembers)>
+{
+    constexpr std::array<std::size_t, sizeof...(TMembers)> alignments{CBlockMember<Layout, TMembers>::k_alignment...};
+    constexpr std::array<std::size_t, sizeof...(TMembers)> sizes{CBlockMember<Layout, TMembers>::k_size...};
+
+    std::array<std::size_t, sizeof...(TMembers)> offsets{ };
+    std::size_t                                  offset{ };
+    for(std::size_t i{ }; i < offsets.size( ); ++i)
+    {
+        offsets[i] = alignOffset(offset, alignments[i]);
+        offset     = offsets[i] + sizes[i];
+    }
+    return offsets;
+}
+
+/// Checks a C++ structure against a block layout, given the offsets of its members. The sizes of the members have to
+/// match as well, which catches the strides of arrays and matrices, e.g. a glm::mat3 in a std140 block:
+///
+///     static_assert(isBlockLayout<EBlockLayout::Std140, glm::mat4, glm::vec4>(
+///         {offsetof(CObjectData, m_model), offsetof(CObjectData, m_color)}));
+template<EBlockLayout Layout, typename... TMembers>
+constexpr auto isBlockLayout(std::array<std::size_t, sizeof...(TMembers)> const & offsets) -> bool
+{
+    constexpr std::array<std::size_t, sizeof...(TMembers)> blockOffsets{getBlockOffsets<Layout, TMembers...>( )};
+    constexpr std::array<bool, sizeof...(TMembers)>        isSizeEqual{
+        (sizeof(TMembers) == CBlockMember<Layout, TMembers>::k_size)...};
+
+    for(std::size_t i{ }; i < offsets.size( ); ++i)
+    {
+        if((offsets[i] != blockOffsets[i]) || !isSizeEqual[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
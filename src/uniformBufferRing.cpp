@@ -0,0 +1,118 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "uniformBufferRing.hpp"
+#include "deviceCaps.hpp"
+#include "error.hpp"
+#include "stateCache.hpp"
+
+#include "fmt/core.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+CUniformBufferRing::~CUniformBufferRing( )
+{
+    destroy( );
+}
+
+CUniformBufferRing::CUniformBufferRing(CUniformBufferRing&& other)
+{
+    *this = std::move(other);
+}
+
+CUniformBufferRing& CUniformBufferRing::operator=(CUniformBufferRing&& other)
+{
+    if(this != &other)
+    {
+        destroy( );
+        m_streamingBuffer = std::move(other.m_streamingBuffer);
+        m_alignment       = std::exchange(other.m_alignment, { });
+        m_maxBlockSize    = std::exchange(other.m_maxBlockSize, { });
+    }
+    return *this;
+}
+
+auto CUniformBufferRing::create(
+    CDeviceCaps const & deviceCaps, GLsizeiptr const frameSize, std::size_t const numFrames) -> void
+{
+    destroy( );
+
+    m_alignment    = static_cast<GLsizeiptr>(deviceCaps.getInteger(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT));
+    m_maxBlockSize = static_cast<GLsizeiptr>(deviceCaps.getInteger(GL_MAX_UNIFORM_BLOCK_SIZE));
+    if(m_alignment <= 0)
+    {
+        throw std::runtime_error(fmt::format("Invalid uniform buffer offset alignment of {}.", m_alignment));
+    }
+
+    m_streamingBuffer.create(deviceCaps, GL_UNIFORM_BUFFER, frameSize, numFrames);
+}
+
+auto CUniformBufferRing::destroy( ) -> void
+{
+    m_streamingBuffer.destroy( );
+    m_alignment    = { };
+    m_maxBlockSize = { };
+}
+
+auto CUniformBufferRing::push(void const * const data, GLsizeiptr const size) -> CUniformBufferSlice
+{
+    if(size > m_maxBlockSize)
+    {
+        throw std::runtime_error(
+            fmt::format("The uniform block of {} bytes exceeds the limit of {} bytes.", size, m_maxBlockSize));
+    }
+
+    CStreamingAllocation const allocation{m_streamingBuffer.allocate(size, m_alignment)};
+    std::memcpy(allocation.m_data, data, static_cast<std::size_t>(size));
+    m_streamingBuffer.finish(allocation);
+
+    return {m_streamingBuffer.getId( ), allocation.m_offset, allocation.m_size};
+}
+
+auto CUniformBufferRing::bind(GLuint const binding, CUniformBufferSlice const & slice) -> void
+{
+    // glBindBufferRange changes the generic binding as well, which the state cache has to know about
+    CStateCache::get( ).bindBuffer(GL_UNIFORM_BUFFER, slice.m_bufferId);
+    GLCheck(glBindBufferRange(GL_UNIFORM_BUFFER, binding, slice.m_bufferId, slice.m_offset, slice.m_size));
+}
+
+auto CUniformBufferRing::endFrame( ) -> void
+{
+    m_streamingBuffer.endFrame( );
+}
+
+auto CUniformBufferRing::getAlignment( ) const -> GLsizeiptr
+{
+    return m_alignment;
+}
+
+auto CUniformBufferRing::getStreamingBuffer( ) const -> CStreamingBuffer const &
+{
+    return m_streamingBuffer;
+}
@@ -0,0 +1,92 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "streamingBuffer.hpp"
+
+#include "glad/glad.h"
+
+#include <cstddef>
+
+class CDeviceCaps;
+
+/// Slice of a uniform buffer ring, valid until the end of the frame.
+struct CUniformBufferSlice
+{
+    GLuint     m_bufferId{ };
+    GLintptr   m_offset{ };
+    GLsizeiptr m_size{ };
+};
+
+/// Per-frame allocator of uniform block data in one large uniform buffer.
+///
+/// Each draw writes its block into a new slice at GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT and binds it with a single
+/// glBindBufferRange, instead of setting the uniforms one by one. The frames rotate through the regions of a
+/// CStreamingBuffer, so the slices of the frames still in flight are never overwritten.
+class CUniformBufferRing
+{
+public:
+    CUniformBufferRing( ) = default;
+    ~CUniformBufferRing( );
+
+    CUniformBufferRing(CUniformBufferRing const & other)            = delete;
+    CUniformBufferRing& operator=(CUniformBufferRing const & other) = delete;
+
+    CUniformBufferRing(CUniformBufferRing&& other);
+    CUniformBufferRing& operator=(CUniformBufferRing&& other);
+
+public:
+    auto create(
+        CDeviceCaps const & deviceCaps,
+        GLsizeiptr const    frameSize,
+        std::size_t const   numFrames = CStreamingBuffer::k_defaultNumRegions) -> void;
+    auto destroy( ) -> void;
+
+    /// Copies the block into a new slice of the current frame.
+    auto push(void const * const data, GLsizeiptr const size) -> CUniformBufferSlice;
+    template<typename TBlock>
+    auto push(TBlock const & block) -> CUniformBufferSlice;
+
+    /// Binds the slice to the binding point of a block, see CUniformBlockBindings.
+    static auto bind(GLuint const binding, CUniformBufferSlice const & slice) -> void;
+    auto endFrame( ) -> void;
+
+    auto getAlignment( ) const -> GLsizeiptr;
+    auto getStreamingBuffer( ) const -> CStreamingBuffer const &;
+
+private:
+    CStreamingBuffer m_streamingBuffer{ };
+    GLsizeiptr       m_alignment{ };
+    GLsizeiptr       m_maxBlockSize{ };
+};
+
+template<typename TBlock>
+auto CUniformBufferRing::push(TBlock const & block) -> CUniformBufferSlice
+{
+    return push(&block, static_cast<GLsizeiptr>(sizeof(TBlock)));
+}
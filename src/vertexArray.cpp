@@ -27,9 +27,13 @@
 
 #include "vertexArray.hpp"
 #include "error.hpp"
+#include "stateCache.hpp"
+#include "stateAccess.hpp"
 
 #include <utility>
 #include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 
 CVertexArray::~CVertexArray( )
 {
@@ -46,7 +50,9 @@ CVertexArray& CVertexArray::operator=(CVertexArray&& other)
     if(this != &other)
     {
         destroy( );
-        m_vertexArrayId = std::exchange(other.m_vertexArrayId, { });
+        m_vertexArrayId           = std::exchange(other.m_vertexArrayId, { });
+        m_numVertexBufferBindings = std::exchange(other.m_numVertexBufferBindings, { });
+        m_vertexFormats           = std::exchange(other.m_vertexFormats, { });
     }
     return *this;
 }
@@ -55,7 +61,14 @@ auto CVertexArray::create( ) -> void
 {
     destroy( );
 
-    GLCheck(glGenVertexArrays(1, &m_vertexArrayId));
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glCreateVertexArrays(1, &m_vertexArrayId));
+    }
+    else
+    {
+        GLCheck(glGenVertexArrays(1, &m_vertexArrayId));
+    }
 }
 
 auto CVertexArray::destroy( ) -> void
@@ -65,46 +78,161 @@ auto CVertexArray::destroy( ) -> void
         return;
     }
     GLCheck(glDeleteVertexArrays(1, &m_vertexArrayId));
-    m_vertexArrayId = { };
+    CStateCache::get( ).forgetVertexArray(m_vertexArrayId);
+    m_vertexArrayId           = { };
+    m_numVertexBufferBindings = { };
+    m_vertexFormats.clear( );
+}
+
+auto CVertexArray::getId( ) const -> GLuint
+{
+    return m_vertexArrayId;
 }
 
 auto CVertexArray::bind( ) const -> void
 {
-    GLCheck(glBindVertexArray(m_vertexArrayId));
+    CStateCache::get( ).bindVertexArray(m_vertexArrayId);
 }
 
 auto CVertexArray::unbind( ) const -> void
 {
-    GLCheck(glBindVertexArray(0));
+    CStateCache::get( ).bindVertexArray(0);
 }
 
-auto CVertexArray::addVertexBuffer(
-    CVertexBuffer const & vertexBuffer, CVertexBufferLayout const & vertexBufferLayout) const -> void
+auto CVertexArray::addVertexBuffer(CVertexBuffer const & vertexBuffer, CVertexBufferLayout const & vertexBufferLayout)
+    -> void
 {
-    bind( );
-    vertexBuffer.bind( );
-
     std::vector<CVertexBufferElement> const & elements{vertexBufferLayout.getElements( )};
     GLsizei const                             stride{vertexBufferLayout.getStride( )};
-    GLsizeiptr                                offset{ };
+    GLuint const                              bindingIndex{bindVertexBuffer(vertexBuffer.getId( ), stride)};
+
+    std::for_each(
+        elements.begin( ), elements.end( ), [this, bindingIndex, stride](CVertexBufferElement const & element) {
+            addAttribute(bindingIndex, stride, element);
+        });
+}
+
+auto CVertexArray::addIndexBuffer(CIndexBuffer const & indexBuffer) -> void
+{
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glVertexArrayElementBuffer(m_vertexArrayId, indexBuffer.getId( )));
+        CStateCache::get( ).forgetElementArrayBuffer(m_vertexArrayId);
+        return;
+    }
+
+    bind( );
+    indexBuffer.bind( );
+}
+
+auto CVertexArray::setVertexFormat(CVertexBufferLayout const & vertexBufferLayout, GLuint const bindingIndex) -> void
+{
+    if(bindingIndex >= m_vertexFormats.size( ))
+    {
+        m_vertexFormats.resize(bindingIndex + 1);
+    }
+    m_vertexFormats.at(bindingIndex) = vertexBufferLayout;
+    m_numVertexBufferBindings        = std::max(m_numVertexBufferBindings, bindingIndex + 1);
+
+    for(CVertexBufferElement const & element : vertexBufferLayout.getElements( ))
+    {
+        addAttributeFormat(bindingIndex, element);
+    }
+}
+
+auto CVertexArray::setVertexBuffer(CVertexBuffer const & vertexBuffer, GLuint const bindingIndex, GLintptr const offset)
+    -> void
+{
+    if(bindingIndex >= m_vertexFormats.size( ))
+    {
+        throw std::out_of_range("The binding point of the vertex buffer has no vertex format.");
+    }
 
-    std::for_each(elements.begin( ), elements.end( ), [stride, &offset](CVertexBufferElement const & element) {
+    CVertexBufferLayout const & vertexFormat{m_vertexFormats.at(bindingIndex)};
+    GLsizei const               stride{vertexFormat.getStride( )};
+
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glVertexArrayVertexBuffer(m_vertexArrayId, bindingIndex, vertexBuffer.getId( ), offset, stride));
+    }
+    else if(CStateAccess::isVertexAttribBinding( ))
+    {
+        bind( );
+        GLCheck(glBindVertexBuffer(bindingIndex, vertexBuffer.getId( ), offset, stride));
+    }
+    else
+    {
+        // Without separate vertex formats the buffer is part of every attribute pointer
+        bind( );
+        CStateCache::get( ).bindBuffer(GL_ARRAY_BUFFER, vertexBuffer.getId( ));
+        for(CVertexBufferElement const & element : vertexFormat.getElements( ))
+        {
+            setAttributePointer(stride, offset, element);
+        }
+    }
+}
+
+auto CVertexArray::bindVertexBuffer(GLuint const vertexBufferId, GLsizei const stride) -> GLuint
+{
+    GLuint const bindingIndex{m_numVertexBufferBindings++};
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glVertexArrayVertexBuffer(m_vertexArrayId, bindingIndex, vertexBufferId, 0, stride));
+    }
+    else
+    {
+        // The attribute pointers capture the array buffer bound when they are specified
+        bind( );
+        CStateCache::get( ).bindBuffer(GL_ARRAY_BUFFER, vertexBufferId);
+    }
+    return bindingIndex;
+}
+
+auto CVertexArray::addAttribute(GLuint const bindingIndex, GLsizei const stride, CVertexBufferElement const & element)
+    const -> void
+{
+    if(CStateAccess::isDirect( ))
+    {
+        addAttributeFormat(bindingIndex, element);
+    }
+    else
+    {
         GLCheck(glEnableVertexAttribArray(static_cast<GLuint>(element.m_vertexAttributeIndex)));
-        GLCheck(glVertexAttribPointer(
-            static_cast<GLuint>(element.m_vertexAttributeIndex), static_cast<GLint>(element.m_numComponents),
-            element.m_componentType, element.m_normalized, stride, reinterpret_cast<void*>(offset)));
+        setAttributePointer(stride, 0, element);
+    }
+}
 
-        offset += (element.m_componentSize * static_cast<GLint>(element.m_numComponents));
-    });
+auto CVertexArray::addAttributeFormat(GLuint const bindingIndex, CVertexBufferElement const & element) const -> void
+{
+    GLuint const attributeIndex{static_cast<GLuint>(element.m_vertexAttributeIndex)};
+    GLint const  numComponents{static_cast<GLint>(element.m_numComponents)};
 
-    unbind();
-    vertexBuffer.unbind();
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glEnableVertexArrayAttrib(m_vertexArrayId, attributeIndex));
+        GLCheck(glVertexArrayAttribFormat(
+            m_vertexArrayId, attributeIndex, numComponents, element.m_componentType, element.m_normalized,
+            element.m_offset));
+        GLCheck(glVertexArrayAttribBinding(m_vertexArrayId, attributeIndex, bindingIndex));
+        return;
+    }
+
+    bind( );
+    GLCheck(glEnableVertexAttribArray(attributeIndex));
+    if(CStateAccess::isVertexAttribBinding( ))
+    {
+        GLCheck(glVertexAttribFormat(
+            attributeIndex, numComponents, element.m_componentType, element.m_normalized, element.m_offset));
+        GLCheck(glVertexAttribBinding(attributeIndex, bindingIndex));
+    }
+    // Otherwise the format is specified together with the vertex buffer by setVertexBuffer
 }
 
-auto CVertexArray::addIndexBuffer(CIndexBuffer const & indexBuffer) const -> void
+auto CVertexArray::setAttributePointer(
+    GLsizei const stride, GLintptr const offset, CVertexBufferElement const & element) const -> void
 {
-    bind();
-    indexBuffer.bind();
-    unbind();
-    indexBuffer.unbind();
+    std::uintptr_t const pointer{static_cast<std::uintptr_t>(offset) + element.m_offset};
+    GLCheck(glVertexAttribPointer(
+        static_cast<GLuint>(element.m_vertexAttributeIndex), static_cast<GLint>(element.m_numComponents),
+        element.m_componentType, element.m_normalized, stride, reinterpret_cast<void*>(pointer)));
 }
@@ -29,10 +29,14 @@
 
 #include "vertexBuffer.hpp"
 #include "vertexBufferLayout.hpp"
+#include "typedVertexBuffer.hpp"
 #include "indexBuffer.hpp"
 
 #include "glad/glad.h"
 
+#include <utility>
+#include <vector>
+
 class CVertexArray
 {
 public:
@@ -49,13 +53,48 @@ public:
     auto create( ) -> void;
     auto destroy( ) -> void;
 
+    auto getId( ) const -> GLuint;
+
     auto bind( ) const -> void;
     auto unbind( ) const -> void;
 
-    auto addVertexBuffer(CVertexBuffer const & vertexBuffer, CVertexBufferLayout const & vertexBufferLayout) const
+    auto addVertexBuffer(CVertexBuffer const & vertexBuffer, CVertexBufferLayout const & vertexBufferLayout) -> void;
+    auto addIndexBuffer(CIndexBuffer const & indexBuffer) -> void;
+
+    /// Specifies the attribute formats of the layout for the binding point without attaching a vertex buffer.
+    auto setVertexFormat(CVertexBufferLayout const & vertexBufferLayout, GLuint const bindingIndex = 0) -> void;
+    /// Attaches the vertex buffer to a binding point, the vertex format of the binding point stays untouched.
+    auto setVertexBuffer(CVertexBuffer const & vertexBuffer, GLuint const bindingIndex = 0, GLintptr const offset = 0)
         -> void;
-    auto addIndexBuffer(CIndexBuffer const & indexBuffer) const -> void;
+
+    template<typename TVertex>
+    auto addVertexBuffer(CTypedVertexBuffer<TVertex> const & vertexBuffer) -> void
+    {
+        using Buffer = CTypedVertexBuffer<TVertex>;
+
+        GLuint const bindingIndex{bindVertexBuffer(vertexBuffer.getId( ), Buffer::k_stride)};
+        addAttributes<TVertex>(bindingIndex, std::make_index_sequence<Buffer::k_elements.size( )>{ });
+    }
+
+private:
+    auto bindVertexBuffer(GLuint const vertexBufferId, GLsizei const stride) -> GLuint;
+    auto addAttribute(GLuint const bindingIndex, GLsizei const stride, CVertexBufferElement const & element) const
+        -> void;
+    auto addAttributeFormat(GLuint const bindingIndex, CVertexBufferElement const & element) const -> void;
+    auto setAttributePointer(GLsizei const stride, GLintptr const offset, CVertexBufferElement const & element) const
+        -> void;
+
+    // The layout of a typed vertex buffer is known at compile time, the attributes are set up without a loop
+    template<typename TVertex, std::size_t... Is>
+    auto addAttributes(GLuint const bindingIndex, std::index_sequence<Is...>) const -> void
+    {
+        using Buffer = CTypedVertexBuffer<TVertex>;
+
+        (addAttribute(bindingIndex, Buffer::k_stride, Buffer::k_elements[Is]), ...);
+    }
 
 private:
-    GLuint m_vertexArrayId{ };
+    GLuint                           m_vertexArrayId{ };
+    GLuint                           m_numVertexBufferBindings{ };
+    std::vector<CVertexBufferLayout> m_vertexFormats{ };
 };
@@ -0,0 +1,97 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "vertexArrayCache.hpp"
+
+#include "fmt/core.h"
+
+#include <stdexcept>
+
+auto CVertexArrayCache::get(CVertexBufferLayout const & vertexBufferLayout) -> CVertexArray&
+{
+    std::uint64_t const hash{vertexBufferLayout.getHash( )};
+    auto const [iterator, isInserted]{m_entries.try_emplace(hash)};
+    CEntry& entry{iterator->second};
+
+    if(!isInserted)
+    {
+        if(entry.m_vertexBufferLayout != vertexBufferLayout)
+        {
+            throw std::runtime_error(fmt::format("Two vertex buffer layouts share the hash {:016x}.", hash));
+        }
+        ++m_statistics.m_numHits;
+        return entry.m_vertexArray;
+    }
+
+    ++m_statistics.m_numMisses;
+    try
+    {
+        entry.m_vertexBufferLayout = vertexBufferLayout;
+        entry.m_vertexArray.create( );
+        entry.m_vertexArray.setVertexFormat(vertexBufferLayout);
+    }
+    catch(...)
+    {
+        m_entries.erase(iterator);
+        throw;
+    }
+    return entry.m_vertexArray;
+}
+
+auto CVertexArrayCache::bind(CVertexBufferLayout const & vertexBufferLayout, CVertexBuffer const & vertexBuffer)
+    -> CVertexArray&
+{
+    CVertexArray& vertexArray{get(vertexBufferLayout)};
+    vertexArray.bind( );
+    vertexArray.setVertexBuffer(vertexBuffer);
+    return vertexArray;
+}
+
+auto CVertexArrayCache::bind(
+    CVertexBufferLayout const & vertexBufferLayout,
+    CVertexBuffer const &       vertexBuffer,
+    CIndexBuffer const &        indexBuffer) -> CVertexArray&
+{
+    CVertexArray& vertexArray{bind(vertexBufferLayout, vertexBuffer)};
+    vertexArray.addIndexBuffer(indexBuffer);
+    return vertexArray;
+}
+
+auto CVertexArrayCache::clear( ) -> void
+{
+    m_entries.clear( );
+}
+
+auto CVertexArrayCache::getSize( ) const -> std::size_t
+{
+    return m_entries.size( );
+}
+
+auto CVertexArrayCache::getStatistics( ) const -> CStatistics
+{
+    return m_statistics;
+}
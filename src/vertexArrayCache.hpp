@@ -0,0 +1,78 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "vertexArray.hpp"
+#include "vertexBuffer.hpp"
+#include "vertexBufferLayout.hpp"
+#include "indexBuffer.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+
+/// Vertex arrays shared by all meshes with the same vertex buffer layout.
+///
+/// Each vertex array holds the attribute formats of one layout, keyed by the hash of the layout. The vertex and index
+/// buffers of a mesh are attached to the binding points right before its draw, so the number of vertex arrays and the
+/// cost of switching between them scale with the number of layouts instead of the number of meshes.
+class CVertexArrayCache
+{
+public:
+    struct CStatistics
+    {
+        std::uint64_t m_numHits{ };
+        std::uint64_t m_numMisses{ };
+    };
+
+public:
+    /// Vertex array with the formats of the layout, created on the first request of the layout.
+    auto get(CVertexBufferLayout const & vertexBufferLayout) -> CVertexArray&;
+
+    /// Binds the vertex array of the layout with the buffers of a mesh attached.
+    auto bind(CVertexBufferLayout const & vertexBufferLayout, CVertexBuffer const & vertexBuffer) -> CVertexArray&;
+    auto bind(
+        CVertexBufferLayout const & vertexBufferLayout,
+        CVertexBuffer const &       vertexBuffer,
+        CIndexBuffer const &        indexBuffer) -> CVertexArray&;
+
+    auto clear( ) -> void;
+
+    auto getSize( ) const -> std::size_t;
+    auto getStatistics( ) const -> CStatistics;
+
+private:
+    struct CEntry
+    {
+        CVertexBufferLayout m_vertexBufferLayout{ };
+        CVertexArray        m_vertexArray{ };
+    };
+
+private:
+    std::unordered_map<std::uint64_t, CEntry> m_entries{ };
+    CStatistics                               m_statistics{ };
+};
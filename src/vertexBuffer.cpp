@@ -27,6 +27,8 @@
 
 #include "vertexBuffer.hpp"
 #include "error.hpp"
+#include "stateCache.hpp"
+#include "stateAccess.hpp"
 
 #include <utility>
 
@@ -55,10 +57,19 @@ auto CVertexBuffer::create(
 {
     destroy( );
 
-    GLCheck(glGenBuffers(1, &m_vertexBufferId));
-    bind( );
-    GLCheck(glBufferData(GL_ARRAY_BUFFER, size * count, data, static_cast<GLenum>(usage)));
-    unbind( );
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glCreateBuffers(1, &m_vertexBufferId));
+        GLsizeiptr const     storageSize{getBufferStorageSize(size * count)};
+        GLvoid const * const storageData{(0 < (size * count)) ? data : nullptr};
+        GLCheck(glNamedBufferStorage(m_vertexBufferId, storageSize, storageData, getUpdatableStorageFlags( )));
+    }
+    else
+    {
+        GLCheck(glGenBuffers(1, &m_vertexBufferId));
+        bind( );
+        GLCheck(glBufferData(GL_ARRAY_BUFFER, size * count, data, static_cast<GLenum>(usage)));
+    }
 }
 
 auto CVertexBuffer::destroy( ) -> void
@@ -68,9 +79,34 @@ auto CVertexBuffer::destroy( ) -> void
         return;
     }
     GLCheck(glDeleteBuffers(1, &m_vertexBufferId));
+    CStateCache::get( ).forgetBuffer(m_vertexBufferId);
     m_vertexBufferId = { };
 }
 
+auto CVertexBuffer::adopt(GLuint const vertexBufferId) -> void
+{
+    destroy( );
+    m_vertexBufferId = vertexBufferId;
+}
+
+auto CVertexBuffer::release( ) -> GLuint
+{
+    return std::exchange(m_vertexBufferId, { });
+}
+
+auto CVertexBuffer::update(GLintptr const offset, GLvoid const * const data, GLsizeiptr const size) -> void
+{
+    if(CStateAccess::isDirect( ))
+    {
+        GLCheck(glNamedBufferSubData(m_vertexBufferId, offset, size, data));
+    }
+    else
+    {
+        bind( );
+        GLCheck(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+    }
+}
+
 auto CVertexBuffer::getId( ) const -> GLuint
 {
     return m_vertexBufferId;
@@ -78,10 +114,10 @@ auto CVertexBuffer::getId( ) const -> GLuint
 
 auto CVertexBuffer::bind( ) const -> void
 {
-    GLCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferId));
+    CStateCache::get( ).bindBuffer(GL_ARRAY_BUFFER, m_vertexBufferId);
 }
 
 auto CVertexBuffer::unbind( ) const -> void
 {
-    GLCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    CStateCache::get( ).bindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -51,6 +51,13 @@ public:
         EBufferUsagePattern const usage = EBufferUsagePattern::StaticDraw) -> void;
     auto destroy( ) -> void;
 
+    /// Takes ownership of a buffer created elsewhere, e.g. by CAsyncUploader.
+    auto adopt(GLuint const vertexBufferId) -> void;
+    /// Gives up ownership of the buffer without deleting it.
+    auto release( ) -> GLuint;
+
+    auto update(GLintptr const offset, GLvoid const * const data, GLsizeiptr const size) -> void;
+
     auto getId( ) const -> GLuint;
 
     auto bind( ) const -> void;
@@ -39,4 +39,27 @@ struct CVertexBufferElement
     GLenum                m_componentType{ };
     GLint                 m_componentSize{ };
     GLboolean             m_normalized{ };
+    GLuint                m_offset{ };
 };
+
+/// Size of the element in the vertex, the packed formats hold all components in one component.
+constexpr auto getVertexBufferElementSize(CVertexBufferElement const & element) -> GLuint
+{
+    bool const isPacked{
+        (GL_INT_2_10_10_10_REV == element.m_componentType) ||
+        (GL_UNSIGNED_INT_2_10_10_10_REV == element.m_componentType)};
+    return static_cast<GLuint>(element.m_componentSize) *
+           (isPacked ? 1U : static_cast<GLuint>(element.m_numComponents));
+}
+
+constexpr auto operator==(CVertexBufferElement const & lhs, CVertexBufferElement const & rhs) -> bool
+{
+    return (lhs.m_vertexAttributeIndex == rhs.m_vertexAttributeIndex) && (lhs.m_numComponents == rhs.m_numComponents) &&
+           (lhs.m_componentType == rhs.m_componentType) && (lhs.m_componentSize == rhs.m_componentSize) &&
+           (lhs.m_normalized == rhs.m_normalized) && (lhs.m_offset == rhs.m_offset);
+}
+
+constexpr auto operator!=(CVertexBufferElement const & lhs, CVertexBufferElement const & rhs) -> bool
+{
+    return !(lhs == rhs);
+}
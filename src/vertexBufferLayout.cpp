@@ -26,26 +26,67 @@
 /// ----------------------------------------------------------------------------
 
 #include "vertexBufferLayout.hpp"
+#include "hash.hpp"
 
 auto CVertexBufferLayout::addFloat(EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents)
     -> void
 {
-    m_elements.push_back({vertexAttributeIndex, numComponents, GL_FLOAT, sizeof(GLfloat), GL_FALSE});
-    m_stride += static_cast<GLint>(numComponents) * sizeof(GLfloat);
+    addElement(vertexAttributeIndex, numComponents, GL_FLOAT, sizeof(GLfloat), GL_FALSE);
 }
 
 auto CVertexBufferLayout::addInt(
     EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized) -> void
 {
-    m_elements.push_back({vertexAttributeIndex, numComponents, GL_INT, sizeof(GLint), normalized});
-    m_stride += static_cast<GLint>(numComponents) * sizeof(GLint);
+    addElement(vertexAttributeIndex, numComponents, GL_INT, sizeof(GLint), normalized);
 }
 
 auto CVertexBufferLayout::addUInt(
     EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized) -> void
 {
-    m_elements.push_back({vertexAttributeIndex, numComponents, GL_UNSIGNED_INT, sizeof(GLuint), normalized});
-    m_stride += static_cast<GLint>(numComponents) * sizeof(GLuint);
+    addElement(vertexAttributeIndex, numComponents, GL_UNSIGNED_INT, sizeof(GLuint), normalized);
+}
+
+auto CVertexBufferLayout::addHalfFloat(EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents)
+    -> void
+{
+    addElement(vertexAttributeIndex, numComponents, GL_HALF_FLOAT, sizeof(GLhalf), GL_FALSE);
+}
+
+auto CVertexBufferLayout::addByte(
+    EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized) -> void
+{
+    addElement(vertexAttributeIndex, numComponents, GL_BYTE, sizeof(GLbyte), normalized);
+}
+
+auto CVertexBufferLayout::addUByte(
+    EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized) -> void
+{
+    addElement(vertexAttributeIndex, numComponents, GL_UNSIGNED_BYTE, sizeof(GLubyte), normalized);
+}
+
+auto CVertexBufferLayout::addShort(
+    EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized) -> void
+{
+    addElement(vertexAttributeIndex, numComponents, GL_SHORT, sizeof(GLshort), normalized);
+}
+
+auto CVertexBufferLayout::addUShort(
+    EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized) -> void
+{
+    addElement(vertexAttributeIndex, numComponents, GL_UNSIGNED_SHORT, sizeof(GLushort), normalized);
+}
+
+auto CVertexBufferLayout::addInt2101010Rev(EVertexAttributeIndex vertexAttributeIndex, GLboolean normalized) -> void
+{
+    // The four components share a single 32-bit integer
+    addElement(vertexAttributeIndex, ENumberOfComponents::Four, GL_INT_2_10_10_10_REV, sizeof(GLuint), normalized);
+}
+
+auto CVertexBufferLayout::addElement(CVertexBufferElement const & element) -> void
+{
+    CVertexBufferElement& addedElement{m_elements.emplace_back(element)};
+    addedElement.m_offset  = static_cast<GLuint>(m_stride);
+    m_stride              += static_cast<GLsizei>(getVertexBufferElementSize(addedElement));
 }
 
 auto CVertexBufferLayout::getStride( ) const -> GLsizei
@@ -57,3 +98,38 @@ auto CVertexBufferLayout::getElements( ) const -> std::vector<CVertexBufferEleme
 {
     return m_elements;
 }
+
+auto CVertexBufferLayout::getHash( ) const -> std::uint64_t
+{
+    std::uint64_t hash{fnv1a(m_stride, k_fnv1aOffsetBasis)};
+    for(CVertexBufferElement const & element : m_elements)
+    {
+        hash = fnv1a(element.m_vertexAttributeIndex, hash);
+        hash = fnv1a(element.m_numComponents, hash);
+        hash = fnv1a(element.m_componentType, hash);
+        hash = fnv1a(element.m_componentSize, hash);
+        hash = fnv1a(element.m_normalized, hash);
+        hash = fnv1a(element.m_offset, hash);
+    }
+    return hash;
+}
+
+auto CVertexBufferLayout::addElement(
+    EVertexAttributeIndex vertexAttributeIndex,
+    ENumberOfComponents   numComponents,
+    GLenum                componentType,
+    GLint                 componentSize,
+    GLboolean             normalized) -> void
+{
+    addElement({vertexAttributeIndex, numComponents, componentType, componentSize, normalized});
+}
+
+auto operator==(CVertexBufferLayout const & lhs, CVertexBufferLayout const & rhs) -> bool
+{
+    return (lhs.getStride( ) == rhs.getStride( )) && (lhs.getElements( ) == rhs.getElements( ));
+}
+
+auto operator!=(CVertexBufferLayout const & lhs, CVertexBufferLayout const & rhs) -> bool
+{
+    return !(lhs == rhs);
+}
@@ -31,6 +31,7 @@
 
 #include "glad/glad.h"
 
+#include <cstdint>
 #include <vector>
 
 class CVertexBufferLayout
@@ -44,10 +45,43 @@ public:
         EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized = GL_FALSE)
         -> void;
 
+    // Packed formats, see vertexPacking.hpp for the converters of float data
+    auto addHalfFloat(EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents) -> void;
+    auto addByte(
+        EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized = GL_FALSE)
+        -> void;
+    auto addUByte(
+        EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized = GL_FALSE)
+        -> void;
+    auto addShort(
+        EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized = GL_FALSE)
+        -> void;
+    auto addUShort(
+        EVertexAttributeIndex vertexAttributeIndex, ENumberOfComponents numComponents, GLboolean normalized = GL_FALSE)
+        -> void;
+    auto addInt2101010Rev(EVertexAttributeIndex vertexAttributeIndex, GLboolean normalized = GL_FALSE) -> void;
+
+    /// Appends a copy of the element, e.g. of another layout, behind the elements added so far.
+    auto addElement(CVertexBufferElement const & element) -> void;
+
     auto getStride( ) const -> GLsizei;
     auto getElements( ) const -> std::vector<CVertexBufferElement> const &;
 
+    /// FNV-1a hash of the elements and the stride, equal layouts have equal hashes.
+    auto getHash( ) const -> std::uint64_t;
+
+private:
+    auto addElement(
+        EVertexAttributeIndex vertexAttributeIndex,
+        ENumberOfComponents   numComponents,
+        GLenum                componentType,
+        GLint                 componentSize,
+        GLboolean             normalized) -> void;
+
 private:
     std::vector<CVertexBufferElement> m_elements{ };
     GLsizei                           m_stride{ };
 };
+
+auto operator==(CVertexBufferLayout const & lhs, CVertexBufferLayout const & rhs) -> bool;
+auto operator!=(CVertexBufferLayout const & lhs, CVertexBufferLayout const & rhs) -> bool;
@@ -0,0 +1,326 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "vertexInterleaver.hpp"
+#include "simd.hpp"
+
+#include "fmt/core.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+constexpr std::size_t k_minBytesPerThread{4 * 1024 * 1024};
+// All elements of a block of vertices are copied before the next block, while its destination is still in the cache
+constexpr std::size_t k_bytesPerBlock{16 * 1024};
+
+struct CStridedCopy
+{
+    std::byte const * m_source{ };
+    std::size_t       m_sourceStride{ };
+    std::byte*        m_destination{ };
+    std::size_t       m_destinationStride{ };
+    std::size_t       m_size{ };
+};
+
+// The size is a constant, the compiler replaces the memcpy with plain loads and stores
+template<std::size_t Size>
+auto copyFixedSize(CStridedCopy const & copy, std::size_t const begin, std::size_t const end) -> void
+{
+    for(std::size_t i{begin}; i < end; ++i)
+    {
+        std::memcpy(
+            copy.m_destination + (i * copy.m_destinationStride), copy.m_source + (i * copy.m_sourceStride), Size);
+    }
+}
+
+auto copyAnySize(CStridedCopy const & copy, std::size_t const begin, std::size_t const end) -> void
+{
+    for(std::size_t i{begin}; i < end; ++i)
+    {
+        std::memcpy(
+            copy.m_destination + (i * copy.m_destinationStride), copy.m_source + (i * copy.m_sourceStride),
+            copy.m_size);
+    }
+}
+
+#ifdef LEARNOGL_SIMD_SSE2
+// Scatters a tightly packed stream of 4, 8 or 16 byte elements with one 16 byte load per 16 / Size vertices. Returns
+// the first vertex that is left for the scalar copy.
+template<std::size_t Size>
+auto scatterPacked(CStridedCopy const & copy, std::size_t const begin, std::size_t const end) -> std::size_t
+{
+    static_assert((4 == Size) || (8 == Size) || (16 == Size), "The elements have to divide the 16 byte loads.");
+    constexpr std::size_t k_numVerticesPerLoad{16 / Size};
+
+    std::size_t i{begin};
+    for(; (i + k_numVerticesPerLoad) <= end; i += k_numVerticesPerLoad)
+    {
+        __m128i    value{_mm_loadu_si128(reinterpret_cast<__m128i const *>(copy.m_source + (i * Size)))};
+        std::byte* destination{copy.m_destination + (i * copy.m_destinationStride)};
+        for(std::size_t vertex{ }; vertex < k_numVerticesPerLoad; ++vertex)
+        {
+            if constexpr(4 == Size)
+            {
+                std::int32_t const word{_mm_cvtsi128_si32(value)};
+                std::memcpy(destination, &word, sizeof(word));
+                value = _mm_srli_si128(value, 4);
+            }
+            else if constexpr(8 == Size)
+            {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destination), value);
+                value = _mm_srli_si128(value, 8);
+            }
+            else
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), value);
+            }
+            destination += copy.m_destinationStride;
+        }
+    }
+    return i;
+}
+
+// Stores the low 8 and the following 4 bytes of a register, one 12 byte element
+auto storeTwelveBytes(std::byte* const destination, __m128i const value) -> void
+{
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(destination), value);
+    std::int32_t const word{_mm_cvtsi128_si32(_mm_srli_si128(value, 8))};
+    std::memcpy(destination + 8, &word, sizeof(word));
+}
+
+// Scatters a tightly packed stream of 12 byte elements, e.g. positions or normals, with three 16 byte loads per four
+// vertices. Returns the first vertex that is left for the scalar copy.
+auto scatterPacked12(CStridedCopy const & copy, std::size_t const begin, std::size_t const end) -> std::size_t
+{
+    std::size_t const stride{copy.m_destinationStride};
+
+    std::size_t i{begin};
+    for(; (i + 4) <= end; i += 4)
+    {
+        __m128i const * const source{reinterpret_cast<__m128i const *>(copy.m_source + (i * 12))};
+        __m128i const         value0{_mm_loadu_si128(source)};
+        __m128i const         value1{_mm_loadu_si128(source + 1)};
+        __m128i const         value2{_mm_loadu_si128(source + 2)};
+        std::byte* const      destination{copy.m_destination + (i * stride)};
+
+        // The vertices start at the bytes 0, 12, 24 and 36 of the three loads
+        storeTwelveBytes(destination, value0);
+        storeTwelveBytes(destination + stride, _mm_or_si128(_mm_srli_si128(value0, 12), _mm_slli_si128(value1, 4)));
+        storeTwelveBytes(
+            destination + (2 * stride), _mm_or_si128(_mm_srli_si128(value1, 8), _mm_slli_si128(value2, 8)));
+        storeTwelveBytes(destination + (3 * stride), _mm_srli_si128(value2, 4));
+    }
+    return i;
+}
+#endif
+
+#ifdef LEARNOGL_SIMD_AVX2
+// Gathers the four byte words of 8 / (size / 4) vertices per iteration into a tightly packed destination. Returns the
+// first vertex that is left for the scalar copy.
+auto gatherPacked(CStridedCopy const & copy, std::size_t const begin, std::size_t const end) -> std::size_t
+{
+    std::size_t const numWords{copy.m_size / 4};
+    std::size_t const numVerticesPerGather{8 / numWords};
+    if((copy.m_sourceStride * numVerticesPerGather) > static_cast<std::size_t>(std::numeric_limits<int>::max( )))
+    {
+        return begin;
+    }
+
+    std::array<int, 8> offsets{ };
+    for(std::size_t lane{ }; lane < offsets.size( ); ++lane)
+    {
+        offsets.at(lane) = static_cast<int>(((lane / numWords) * copy.m_sourceStride) + ((lane % numWords) * 4));
+    }
+    __m256i const laneOffsets{_mm256_loadu_si256(reinterpret_cast<__m256i const *>(offsets.data( )))};
+
+    std::size_t i{begin};
+    for(; (i + numVerticesPerGather) <= end; i += numVerticesPerGather)
+    {
+        int const * const base{reinterpret_cast<int const *>(copy.m_source + (i * copy.m_sourceStride))};
+        __m256i const     words{_mm256_i32gather_epi32(base, laneOffsets, 1)};
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(copy.m_destination + (i * copy.m_size)), words);
+    }
+    return i;
+}
+#endif
+
+auto copyVertices(CStridedCopy const & copy, std::size_t begin, std::size_t const end) -> void
+{
+#ifdef LEARNOGL_SIMD_SSE2
+    // Interleaving reads tightly packed streams
+    if(copy.m_sourceStride == copy.m_size)
+    {
+        switch(copy.m_size)
+        {
+            // clang-format off
+            case 4:  begin = scatterPacked<4>(copy, begin, end);  break;
+            case 8:  begin = scatterPacked<8>(copy, begin, end);  break;
+            case 12: begin = scatterPacked12(copy, begin, end);   break;
+            case 16: begin = scatterPacked<16>(copy, begin, end); break;
+            default:                                              break;
+            // clang-format on
+        }
+    }
+#endif
+
+#ifdef LEARNOGL_SIMD_AVX2
+    bool const isGatherable{
+        (copy.m_destinationStride == copy.m_size) &&
+        ((4 == copy.m_size) || (8 == copy.m_size) || (16 == copy.m_size) || (32 == copy.m_size))};
+    if(isGatherable)
+    {
+        begin = gatherPacked(copy, begin, end);
+    }
+#endif
+
+    switch(copy.m_size)
+    {
+        // clang-format off
+        case 1:  copyFixedSize<1>(copy, begin, end);  break;
+        case 2:  copyFixedSize<2>(copy, begin, end);  break;
+        case 3:  copyFixedSize<3>(copy, begin, end);  break;
+        case 4:  copyFixedSize<4>(copy, begin, end);  break;
+        case 6:  copyFixedSize<6>(copy, begin, end);  break;
+        case 8:  copyFixedSize<8>(copy, begin, end);  break;
+        case 12: copyFixedSize<12>(copy, begin, end); break;
+        case 16: copyFixedSize<16>(copy, begin, end); break;
+        default: copyAnySize(copy, begin, end);       break;
+        // clang-format on
+    }
+}
+
+// Every thread copies all elements of a contiguous range of vertices
+auto copyAll(std::vector<CStridedCopy> const & copies, std::size_t const numVertices, std::size_t const vertexSize)
+    -> void
+{
+    std::size_t const maxThreads{std::max<std::size_t>(std::thread::hardware_concurrency( ), 1)};
+    std::size_t const numThreads{
+        std::clamp<std::size_t>((numVertices * vertexSize) / k_minBytesPerThread, 1, maxThreads)};
+    std::size_t const numVerticesPerThread{(numVertices + numThreads - 1) / numThreads};
+    std::size_t const numVerticesPerBlock{
+        std::max<std::size_t>(k_bytesPerBlock / std::max<std::size_t>(vertexSize, 1), 1)};
+
+    auto const copyRange{[&copies, numVerticesPerBlock](std::size_t const begin, std::size_t const end) {
+        for(std::size_t blockBegin{begin}; blockBegin < end; blockBegin += numVerticesPerBlock)
+        {
+            std::size_t const blockEnd{std::min(blockBegin + numVerticesPerBlock, end)};
+            for(CStridedCopy const & copy : copies)
+            {
+                copyVertices(copy, blockBegin, blockEnd);
+            }
+        }
+    }};
+
+    std::vector<std::future<void>> workers{ };
+    for(std::size_t thread{1}; thread < numThreads; ++thread)
+    {
+        std::size_t const begin{std::min(thread * numVerticesPerThread, numVertices)};
+        std::size_t const end{std::min(begin + numVerticesPerThread, numVertices)};
+        workers.push_back(std::async(std::launch::async, copyRange, begin, end));
+    }
+    copyRange(0, std::min(numVerticesPerThread, numVertices));
+
+    for(std::future<void>& worker : workers)
+    {
+        worker.get( );
+    }
+}
+}
+
+auto CVertexInterleaver::interleave(std::vector<CVertexStream> const & streams, std::size_t const numVertices)
+    -> CInterleavedVertices
+{
+    CInterleavedVertices interleaved{ };
+    interleaved.m_numVertices = numVertices;
+
+    for(CVertexStream const & stream : streams)
+    {
+        if((nullptr == stream.m_data) || (nullptr == stream.m_layout))
+        {
+            throw std::runtime_error("A vertex stream without data or layout can not be interleaved.");
+        }
+        for(CVertexBufferElement const & element : stream.m_layout->getElements( ))
+        {
+            interleaved.m_layout.addElement(element);
+        }
+    }
+
+    std::size_t const stride{static_cast<std::size_t>(interleaved.m_layout.getStride( ))};
+    interleaved.m_data.resize(stride * numVertices);
+
+    std::vector<CStridedCopy> copies{ };
+    auto                      interleavedElement{interleaved.m_layout.getElements( ).begin( )};
+    for(CVertexStream const & stream : streams)
+    {
+        std::byte const * const source{static_cast<std::byte const *>(stream.m_data)};
+        for(CVertexBufferElement const & element : stream.m_layout->getElements( ))
+        {
+            copies.push_back(
+                {source + element.m_offset, static_cast<std::size_t>(stream.m_layout->getStride( )),
+                 interleaved.m_data.data( ) + interleavedElement->m_offset, stride,
+                 getVertexBufferElementSize(element)});
+            ++interleavedElement;
+        }
+    }
+
+    copyAll(copies, numVertices, stride);
+    return interleaved;
+}
+
+auto CVertexInterleaver::deinterleave(
+    GLvoid const * const data, CVertexBufferLayout const & layout, std::size_t const numVertices)
+    -> std::vector<std::vector<std::byte>>
+{
+    if(nullptr == data)
+    {
+        throw std::runtime_error("Vertices without data can not be deinterleaved.");
+    }
+
+    std::byte const * const             source{static_cast<std::byte const *>(data)};
+    std::size_t const                   stride{static_cast<std::size_t>(layout.getStride( ))};
+    std::vector<std::vector<std::byte>> streams{ };
+    std::vector<CStridedCopy>           copies{ };
+
+    streams.reserve(layout.getElements( ).size( ));
+    for(CVertexBufferElement const & element : layout.getElements( ))
+    {
+        std::size_t const size{getVertexBufferElementSize(element)};
+        std::byte* const  destination{streams.emplace_back(size * numVertices).data( )};
+        copies.push_back({source + element.m_offset, stride, destination, size, size});
+    }
+
+    copyAll(copies, numVertices, stride);
+    return streams;
+}
@@ -0,0 +1,80 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "vertexBufferLayout.hpp"
+
+#include "glad/glad.h"
+
+#include <cstddef>
+#include <vector>
+
+/// Attribute data of one vertex buffer, e.g. an array of positions, laid out by its layout.
+struct CVertexStream
+{
+    GLvoid const *              m_data{ };
+    CVertexBufferLayout const * m_layout{ };
+};
+
+/// Vertices of several streams in a single buffer, ready for CVertexBuffer::create and CVertexArray::addVertexBuffer.
+struct CInterleavedVertices
+{
+    std::vector<std::byte> m_data{ };
+    CVertexBufferLayout    m_layout{ };
+    std::size_t            m_numVertices{ };
+};
+
+/// Converts between separate attribute streams and a single interleaved vertex buffer.
+///
+/// The elements are copied one by one, the padding of the source layouts is dropped. The vertices are processed in
+/// blocks that fit the cache, every element of a block is copied before the next block. When interleaving, tightly
+/// packed elements of 4, 8, 12 or 16 bytes are scattered from 16 byte SSE2 loads. When deinterleaving, elements of 4,
+/// 8, 16 or 32 bytes are gathered with AVX2 if LEARNOGL_VERTEX_PACKING_AVX2 is enabled. Inputs of more than a few
+/// megabytes are split across threads.
+class CVertexInterleaver
+{
+public:
+    CVertexInterleaver( )                                           = delete;
+    ~CVertexInterleaver( )                                          = delete;
+
+    CVertexInterleaver(CVertexInterleaver const & other)            = delete;
+    CVertexInterleaver& operator=(CVertexInterleaver const & other) = delete;
+
+    CVertexInterleaver(CVertexInterleaver&& other)                  = delete;
+    CVertexInterleaver& operator=(CVertexInterleaver&& other)       = delete;
+
+public:
+    static auto interleave(std::vector<CVertexStream> const & streams, std::size_t const numVertices)
+        -> CInterleavedVertices;
+
+    /// Splits the vertices into one tightly packed stream per element of the layout, in the order of the elements.
+    static auto deinterleave(
+        GLvoid const * const        data,
+        CVertexBufferLayout const & layout,
+        std::size_t const           numVertices) -> std::vector<std::vector<std::byte>>;
+};
@@ -0,0 +1,316 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#include "vertexPacking.hpp"
+#include "simd.hpp"
+
+#include "fmt/core.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::uint32_t k_signMask{0x8000'0000};
+constexpr std::uint32_t k_float32Infinity{255U << 23};
+constexpr std::uint32_t k_float16Max{(127U + 16U) << 23};
+constexpr std::uint32_t k_float16MinNormal{(127U - 14U) << 23};
+constexpr std::uint32_t k_float16SubnormalMagic{((127U - 15U) + (23U - 10U) + 1U) << 23};
+constexpr std::uint32_t k_float16NormalBias{0xFFFU - ((127U - 15U) << 23)};
+
+auto toBits(float const value) -> std::uint32_t
+{
+    std::uint32_t bits{ };
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+auto fromBits(std::uint32_t const bits) -> float
+{
+    float value{ };
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Matches the clamping of _mm_max_ps and _mm_min_ps, NaN is clamped to the minimum
+auto toNormalized(float const value, float const min, float const max, float const scale) -> int
+{
+    float const clampedBelow{(value > min) ? value : min};
+    float const clamped{(clampedBelow < max) ? clampedBelow : max};
+    return static_cast<int>(std::nearbyint(clamped * scale));
+}
+
+#ifdef LEARNOGL_SIMD_SSE2
+auto toNormalized(float const * const source, __m128 const min, __m128 const max, __m128 const scale) -> __m128i
+{
+    __m128 const clamped{_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source), min), max)};
+    return _mm_cvtps_epi32(_mm_mul_ps(clamped, scale));
+}
+
+// Two halves of 8 converted floats, the packing instructions operate on 128 bits
+struct CConverted8
+{
+    __m128i m_low{ };
+    __m128i m_high{ };
+};
+
+auto toNormalized8(float const * const source, float const min, float const max, float const scale) -> CConverted8
+{
+#ifdef LEARNOGL_SIMD_AVX2
+    __m256 const  value{_mm256_loadu_ps(source)};
+    __m256 const  clamped{_mm256_min_ps(_mm256_max_ps(value, _mm256_set1_ps(min)), _mm256_set1_ps(max))};
+    __m256i const converted{_mm256_cvtps_epi32(_mm256_mul_ps(clamped, _mm256_set1_ps(scale)))};
+    return {_mm256_castsi256_si128(converted), _mm256_extracti128_si256(converted, 1)};
+#else
+    __m128 const minValue{_mm_set1_ps(min)};
+    __m128 const maxValue{_mm_set1_ps(max)};
+    __m128 const scaleValue{_mm_set1_ps(scale)};
+    return {
+        toNormalized(source, minValue, maxValue, scaleValue), toNormalized(source + 4, minValue, maxValue, scaleValue)};
+#endif
+}
+
+// Round to nearest even conversion of 4 floats to half floats, sign extended to 32 bits for _mm_packs_epi32
+auto toHalfFloats(__m128 const value) -> __m128i
+{
+    __m128 const  sign{_mm_and_ps(_mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(k_signMask))), value)};
+    __m128 const  absolute{_mm_xor_ps(value, sign)};
+    __m128i const absoluteBits{_mm_castps_si128(absolute)};
+
+    __m128 const  isNaN{_mm_cmpunord_ps(absolute, absolute)};
+    __m128i const isRegular{_mm_cmpgt_epi32(_mm_set1_epi32(static_cast<int>(k_float16Max)), absoluteBits)};
+    __m128i const quietNaN{_mm_and_si128(_mm_castps_si128(isNaN), _mm_set1_epi32(0x200))};
+    __m128i const special{_mm_or_si128(quietNaN, _mm_set1_epi32(0x7C00))};
+
+    __m128i const subnormalMagic{_mm_set1_epi32(static_cast<int>(k_float16SubnormalMagic))};
+    __m128i const isSubnormal{_mm_cmpgt_epi32(_mm_set1_epi32(static_cast<int>(k_float16MinNormal)), absoluteBits)};
+    __m128i const subnormal{
+        _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic))), subnormalMagic)};
+
+    __m128i const isMantissaOdd{_mm_srai_epi32(_mm_slli_epi32(absoluteBits, 31 - 13), 31)};
+    __m128i const rounded{_mm_sub_epi32(
+        _mm_add_epi32(absoluteBits, _mm_set1_epi32(static_cast<int>(k_float16NormalBias))), isMantissaOdd)};
+    __m128i const normal{_mm_srli_epi32(rounded, 13)};
+
+    __m128i const finite{_mm_or_si128(_mm_and_si128(subnormal, isSubnormal), _mm_andnot_si128(isSubnormal, normal))};
+    __m128i const joined{_mm_or_si128(_mm_and_si128(finite, isRegular), _mm_andnot_si128(isRegular, special))};
+    return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+#endif
+}
+
+auto toHalfFloat(float const value) -> CHalfFloat
+{
+    std::uint32_t       bits{toBits(value)};
+    std::uint32_t const sign{bits & k_signMask};
+    bits ^= sign;
+
+    std::uint32_t half{ };
+    if(bits >= k_float16Max)
+    {
+        // Infinity stays infinity, NaN becomes a quiet NaN
+        half = (bits > k_float32Infinity) ? 0x7E00 : 0x7C00;
+    }
+    else if(bits < k_float16MinNormal)
+    {
+        // The addition of the magic number rounds the mantissa of the subnormal half float
+        half = toBits(fromBits(bits) + fromBits(k_float16SubnormalMagic)) - k_float16SubnormalMagic;
+    }
+    else
+    {
+        std::uint32_t const isMantissaOdd{(bits >> 13) & 1};
+        half = (bits + k_float16NormalBias + isMantissaOdd) >> 13;
+    }
+    return {static_cast<std::uint16_t>(half | (sign >> 16))};
+}
+
+auto toFloat(CHalfFloat const value) -> float
+{
+    constexpr std::uint32_t k_shiftedExponent{0x7C00U << 13};
+
+    std::uint32_t       bits{(value.m_bits & 0x7FFFU) << 13};
+    std::uint32_t const exponent{bits & k_shiftedExponent};
+    bits += (127U - 15U) << 23;
+
+    if(k_shiftedExponent == exponent)
+    {
+        bits += (128U - 16U) << 23;
+    }
+    else if(0 == exponent)
+    {
+        bits += 1U << 23;
+        bits  = toBits(fromBits(bits) - fromBits(113U << 23));
+    }
+    return fromBits(bits | ((value.m_bits & 0x8000U) << 16));
+}
+
+auto packHalfFloats(float const * const source, std::size_t const count, CHalfFloat* const destination) -> void
+{
+    std::size_t i{ };
+
+#if defined(LEARNOGL_SIMD_F16C)
+    for(; (i + 8) <= count; i += 8)
+    {
+        __m128i const packed{_mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT)};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+    }
+#elif defined(LEARNOGL_SIMD_SSE2)
+    for(; (i + 8) <= count; i += 8)
+    {
+        __m128i const low{toHalfFloats(_mm_loadu_ps(source + i))};
+        __m128i const high{toHalfFloats(_mm_loadu_ps(source + i + 4))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi32(low, high));
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        destination[i] = toHalfFloat(source[i]);
+    }
+}
+
+auto packSnorm8(float const * const source, std::size_t const count, GLbyte* const destination) -> void
+{
+    std::size_t i{ };
+
+#ifdef LEARNOGL_SIMD_SSE2
+    for(; (i + 16) <= count; i += 16)
+    {
+        CConverted8 const low{toNormalized8(source + i, -1.0F, 1.0F, 127.0F)};
+        CConverted8 const high{toNormalized8(source + i + 8, -1.0F, 1.0F, 127.0F)};
+        __m128i const     lowPacked{_mm_packs_epi32(low.m_low, low.m_high)};
+        __m128i const     highPacked{_mm_packs_epi32(high.m_low, high.m_high)};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi16(lowPacked, highPacked));
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        destination[i] = static_cast<GLbyte>(toNormalized(source[i], -1.0F, 1.0F, 127.0F));
+    }
+}
+
+auto packUnorm8(float const * const source, std::size_t const count, GLubyte* const destination) -> void
+{
+    std::size_t i{ };
+
+#ifdef LEARNOGL_SIMD_SSE2
+    for(; (i + 16) <= count; i += 16)
+    {
+        CConverted8 const low{toNormalized8(source + i, 0.0F, 1.0F, 255.0F)};
+        CConverted8 const high{toNormalized8(source + i + 8, 0.0F, 1.0F, 255.0F)};
+        __m128i const     lowPacked{_mm_packs_epi32(low.m_low, low.m_high)};
+        __m128i const     highPacked{_mm_packs_epi32(high.m_low, high.m_high)};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(lowPacked, highPacked));
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        destination[i] = static_cast<GLubyte>(toNormalized(source[i], 0.0F, 1.0F, 255.0F));
+    }
+}
+
+auto packSnorm16(float const * const source, std::size_t const count, GLshort* const destination) -> void
+{
+    std::size_t i{ };
+
+#ifdef LEARNOGL_SIMD_SSE2
+    for(; (i + 8) <= count; i += 8)
+    {
+        CConverted8 const converted{toNormalized8(source + i, -1.0F, 1.0F, 32767.0F)};
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi32(converted.m_low, converted.m_high));
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        destination[i] = static_cast<GLshort>(toNormalized(source[i], -1.0F, 1.0F, 32767.0F));
+    }
+}
+
+auto packUnorm16(float const * const source, std::size_t const count, GLushort* const destination) -> void
+{
+    std::size_t i{ };
+
+#ifdef LEARNOGL_SIMD_SSE2
+    // SSE2 lacks the unsigned saturating pack, the values are biased into the signed range and back
+    __m128i const bias32{_mm_set1_epi32(32768)};
+    __m128i const bias16{_mm_set1_epi16(static_cast<short>(0x8000))};
+    for(; (i + 8) <= count; i += 8)
+    {
+        CConverted8 const converted{toNormalized8(source + i, 0.0F, 1.0F, 65535.0F)};
+        __m128i const     biased{
+            _mm_packs_epi32(_mm_sub_epi32(converted.m_low, bias32), _mm_sub_epi32(converted.m_high, bias32))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_xor_si128(biased, bias16));
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        destination[i] = static_cast<GLushort>(toNormalized(source[i], 0.0F, 1.0F, 65535.0F));
+    }
+}
+
+auto packInt2101010Rev(
+    float const * const   source,
+    std::size_t const     numVectors,
+    std::size_t const     numComponents,
+    CInt2101010Rev* const destination) -> void
+{
+    if((3 != numComponents) && (4 != numComponents))
+    {
+        throw std::runtime_error(
+            fmt::format("GL_INT_2_10_10_10_REV packs three or four components, not {}.", numComponents));
+    }
+
+    for(std::size_t i{ }; i < numVectors; ++i)
+    {
+        float const * const vector{source + (i * numComponents)};
+        float const         w{(4 == numComponents) ? vector[3] : 0.0F};
+        std::array<int, 4>  components{ };
+
+#ifdef LEARNOGL_SIMD_SSE2
+        __m128 const value{_mm_setr_ps(vector[0], vector[1], vector[2], w)};
+        __m128 const clamped{_mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0F)), _mm_set1_ps(1.0F))};
+        __m128i const converted{_mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_setr_ps(511.0F, 511.0F, 511.0F, 1.0F)))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(components.data( )), converted);
+#else
+        components = {
+            toNormalized(vector[0], -1.0F, 1.0F, 511.0F), toNormalized(vector[1], -1.0F, 1.0F, 511.0F),
+            toNormalized(vector[2], -1.0F, 1.0F, 511.0F), toNormalized(w, -1.0F, 1.0F, 1.0F)};
+#endif
+
+        destination[i].m_bits = (static_cast<std::uint32_t>(components[0]) & 0x3FFU) |
+                                ((static_cast<std::uint32_t>(components[1]) & 0x3FFU) << 10) |
+                                ((static_cast<std::uint32_t>(components[2]) & 0x3FFU) << 20) |
+                                ((static_cast<std::uint32_t>(components[3]) & 0x3U) << 30);
+    }
+}
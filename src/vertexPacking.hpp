@@ -0,0 +1,64 @@
+/// ----------------------------------------------------------------------------
+/// MIT License
+///
+/// @copyright Copyright (c) 2023 Albert Kasdorf
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to
+/// deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+/// sell copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+/// IN THE SOFTWARE.
+/// ----------------------------------------------------------------------------
+/// @file
+/// @author albert.kasdorf@live.de
+/// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "glad/glad.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// IEEE 754 half precision float, the component of a GL_HALF_FLOAT attribute.
+struct CHalfFloat
+{
+    std::uint16_t m_bits{ };
+};
+
+/// Four signed components of 10, 10, 10 and 2 bits, the GL_INT_2_10_10_10_REV attribute of e.g. normals.
+struct CInt2101010Rev
+{
+    std::uint32_t m_bits{ };
+};
+
+// Converters of float arrays into the packed vertex attribute formats, the count is the number of floats. The
+// normalized formats clamp to [-1, 1] or [0, 1] and round to the nearest value. The conversions use SSE2, and AVX2
+// and F16C if LEARNOGL_VERTEX_PACKING_AVX2 is enabled, the results do not depend on the instruction set.
+auto packHalfFloats(float const * const source, std::size_t const count, CHalfFloat* const destination) -> void;
+auto packSnorm8(float const * const source, std::size_t const count, GLbyte* const destination) -> void;
+auto packUnorm8(float const * const source, std::size_t const count, GLubyte* const destination) -> void;
+auto packSnorm16(float const * const source, std::size_t const count, GLshort* const destination) -> void;
+auto packUnorm16(float const * const source, std::size_t const count, GLushort* const destination) -> void;
+
+/// Packs vectors of three or four floats, a missing fourth component is packed as 0.
+auto packInt2101010Rev(
+    float const * const   source,
+    std::size_t const     numVectors,
+    std::size_t const     numComponents,
+    CInt2101010Rev* const destination) -> void;
+
+auto toHalfFloat(float const value) -> CHalfFloat;
+auto toFloat(CHalfFloat const value) -> float;